@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// @brief Reproducible maps for the benchmarks, as rows in the format read by PathFinder::set(). The start is always
+/// the top left cell and the end the bottom right one, or the center of the spirals.
+namespace corpus {
+
+enum Kind { OPEN, RANDOM_10, RANDOM_20, RANDOM_30, MAZE, SPIRAL, KIND_COUNT };
+
+using Rows = std::vector<std::string>;
+
+inline const char *
+name(int kind) {
+    static const char *NAMES[KIND_COUNT] = {"open", "random10", "random20", "random30", "maze", "spiral"};
+    return NAMES[kind];
+}
+
+/// @brief Checks if the end can be reached from the start, with a breadth first search.
+inline bool
+connected(const Rows &rows, int size) {
+    std::vector<uint8_t>             seen(size * size, 0);
+    std::vector<std::pair<int, int>> queue = {{0, 0}};
+    seen[0]                                = 1;
+    for(size_t idx = 0; idx < queue.size(); idx++) {
+        const auto [x, y] = queue[idx];
+        if(rows[y][x] == 'E') {
+            return true;
+        }
+        const int moves[4][2] = {{0, -1}, {1, 0}, {0, 1}, {-1, 0}};
+        for(const auto &move : moves) {
+            const int nx = x + move[0];
+            const int ny = y + move[1];
+            if(nx >= 0 && ny >= 0 && nx < size && ny < size && rows[ny][nx] != '#' && !seen[ny * size + nx]) {
+                seen[ny * size + nx] = 1;
+                queue.push_back({nx, ny});
+            }
+        }
+    }
+    return false;
+}
+
+/// @brief Walls dropped on every cell with the given probability, in percent. Maps without a path are discarded, so the
+/// benchmarks always measure a full search.
+inline Rows
+random(int size, int density, uint32_t seed) {
+    std::mt19937 rng(seed);
+    Rows         rows;
+    do {
+        rows.assign(size, std::string(size, '.'));
+        for(auto &row : rows) {
+            for(char &cell : row) {
+                if((int)(rng() % 100) < density) {
+                    cell = '#';
+                }
+            }
+        }
+        rows.front().front() = 'S';
+        rows.back().back()   = 'E';
+    } while(!connected(rows, size));
+    return rows;
+}
+
+/// @brief Perfect maze carved by a depth first search over the cells of even coordinates, so there is a single path
+/// between any two of them and it winds through most of the map.
+inline Rows
+maze(int size, uint32_t seed) {
+    const int moves[4][2] = {{0, -2}, {2, 0}, {0, 2}, {-2, 0}};
+
+    std::mt19937                     rng(seed);
+    Rows                             rows(size, std::string(size, '#'));
+    std::vector<std::pair<int, int>> stack = {{0, 0}};
+    rows[0][0]                             = '.';
+    while(!stack.empty()) {
+        const auto [x, y] = stack.back();
+        int        options[4];
+        int        count = 0;
+        for(int dir = 0; dir < 4; dir++) {
+            const int nx = x + moves[dir][0];
+            const int ny = y + moves[dir][1];
+            if(nx >= 0 && ny >= 0 && nx < size && ny < size && rows[ny][nx] == '#') {
+                options[count++] = dir;
+            }
+        }
+        if(count == 0) {
+            stack.pop_back();
+            continue;
+        }
+        const int dir = options[rng() % count];
+        const int nx  = x + moves[dir][0];
+        const int ny  = y + moves[dir][1];
+        rows[y + moves[dir][1] / 2][x + moves[dir][0] / 2] = '.';
+        rows[ny][nx]                                       = '.';
+        stack.push_back({nx, ny});
+    }
+
+    // With an even size the last row has no carved cell, open it to reach the corner
+    if(size % 2 == 0) {
+        rows.back().assign(size, '.');
+    }
+    rows.front().front() = 'S';
+    rows.back().back()   = 'E';
+    return rows;
+}
+
+/// @brief Nested square walls, each with a single gap on alternating sides, so the only way to the center is a spiral
+/// covering the whole map.
+inline Rows
+spiral(int size) {
+    Rows rows(size, std::string(size, '.'));
+    for(int ring = 1; 2 * ring < size / 2; ring++) {
+        const int low  = 2 * ring;
+        const int high = size - 1 - 2 * ring;
+        for(int idx = low; idx <= high; idx++) {
+            rows[low][idx] = rows[high][idx] = rows[idx][low] = rows[idx][high] = '#';
+        }
+        if(ring % 2 == 1) {
+            rows[low][low + 1] = '.';
+        } else {
+            rows[high][high - 1] = '.';
+        }
+    }
+    rows.front().front()     = 'S';
+    rows[size / 2][size / 2] = 'E';
+    return rows;
+}
+
+/// @brief Map of the given kind and size, generated once and kept for the following benchmarks.
+inline const Rows &
+get(int kind, int size) {
+    static std::map<std::pair<int, int>, Rows> cache;
+
+    auto found = cache.find({kind, size});
+    if(found != cache.end()) {
+        return found->second;
+    }
+    Rows rows;
+    switch(kind) {
+        case RANDOM_10:
+            rows = random(size, 10, 10);
+            break;
+        case RANDOM_20:
+            rows = random(size, 20, 20);
+            break;
+        case RANDOM_30:
+            rows = random(size, 30, 30);
+            break;
+        case MAZE:
+            rows = maze(size, 1);
+            break;
+        case SPIRAL:
+            rows = spiral(size);
+            break;
+        default:
+            rows = random(size, 0, 0);
+            break;
+    }
+    return cache.emplace(std::make_pair(kind, size), std::move(rows)).first->second;
+}
+
+}    // namespace corpus
@@ -0,0 +1,55 @@
+#include <pathfinder/ParallelPathFinder.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <thread>
+
+using namespace cam::pathfinder;
+using namespace cam::math;
+
+static std::shared_ptr<const Grid>
+randomGrid(int size, int density, uint32_t seed) {
+    std::mt19937 rng(seed);
+    auto         grid = std::make_shared<Grid>(size, size);
+    for(int y = 0; y < size; y++) {
+        for(int x = 0; x < size; x++) {
+            if((int)(rng() % 100) < density) {
+                grid->set(x, y, BLOCK);
+            }
+        }
+    }
+    return grid;
+}
+
+static std::vector<Query>
+randomQueries(const Grid &grid, size_t count, uint32_t seed) {
+    std::mt19937       rng(seed);
+    std::vector<Query> queries;
+    while(queries.size() < count) {
+        Vector2i from(rng() % grid.getWidth(), rng() % grid.getHeight());
+        Vector2i to(rng() % grid.getWidth(), rng() % grid.getHeight());
+        if(!grid.isBlocked(grid.index(from.getX(), from.getY())) && !grid.isBlocked(grid.index(to.getX(), to.getY()))) {
+            queries.push_back({from, to});
+        }
+    }
+    return queries;
+}
+
+// Throughput of a batch of queries on a 256x256 map with 20% of obstacles, from one thread to all the hardware threads
+static void
+BM_ParallelBatch(benchmark::State &state) {
+    static auto grid    = randomGrid(256, 20, 1);
+    static auto queries = randomQueries(*grid, 2048, 2);
+
+    ParallelPathFinder       pathFinder(grid, state.range(0));
+    std::vector<QueryResult> results;
+    pathFinder.setStrategy(Strategy::JUMP_POINT);
+    for(auto _ : state) {
+        pathFinder.solveBatch(queries, results);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_ParallelBatch)->RangeMultiplier(2)->Range(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime()->Unit(benchmark::kMillisecond);
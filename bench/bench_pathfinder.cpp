@@ -0,0 +1,96 @@
+#include "MapCorpus.hpp"
+
+#include <pathfinder/PathFinder.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <iostream>
+#include <sstream>
+
+using namespace cam::pathfinder;
+
+// Every benchmark runs on each map kind from 64x64 up to 4096x4096, with the arguments (kind, size)
+static void
+corpusArguments(benchmark::internal::Benchmark *bench) {
+    bench->ArgNames({"map", "size"});
+    for(int kind = 0; kind < corpus::KIND_COUNT; kind++) {
+        for(int size = 64; size <= 4096; size *= 4) {
+            bench->Args({kind, size});
+        }
+    }
+}
+
+// Loads the map of the benchmark arguments and reports the work and memory of a search on it, measured once outside the
+// timed loop so the statistics don't slow it down. The lazy search of the equivalent paths is included on request.
+static void
+prepare(benchmark::State &state, PathFinder &finder, Strategy strategy, bool alternatives = false) {
+    state.SetLabel(corpus::name(state.range(0)));
+    finder.set(corpus::get(state.range(0), state.range(1)));
+    finder.setStrategy(strategy);
+    finder.setStatsEnabled(true);
+    finder.solve();
+    if(alternatives) {
+        finder.alternatives();
+    }
+    state.counters["bytes"]    = finder.stats().bytes;
+    state.counters["expanded"] = finder.stats().expanded;
+    state.counters["peakOpen"] = finder.stats().peakOpen;
+    state.counters["cost"]     = finder.cost();
+    finder.setStatsEnabled(false);
+}
+
+// A* listing every equivalent optimal path, the default strategy
+static void
+BM_Solve(benchmark::State &state) {
+    PathFinder finder;
+    prepare(state, finder, Strategy::A_STAR);
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(finder.solve());
+    }
+}
+BENCHMARK(BM_Solve)->Apply(corpusArguments)->Unit(benchmark::kMillisecond);
+
+// Single optimal path with Jump Point Search
+static void
+BM_SolveJumpPoint(benchmark::State &state) {
+    PathFinder finder;
+    prepare(state, finder, Strategy::JUMP_POINT);
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(finder.solve());
+    }
+}
+BENCHMARK(BM_SolveJumpPoint)->Apply(corpusArguments)->Unit(benchmark::kMillisecond);
+
+// Equivalent paths searched lazily after a Jump Point Search, counted and the first one enumerated
+static void
+BM_Alternatives(benchmark::State &state) {
+    PathFinder finder;
+    prepare(state, finder, Strategy::JUMP_POINT, true);
+    for(auto _ : state) {
+        state.PauseTiming();
+        finder.solve();
+        state.ResumeTiming();
+        auto paths = finder.alternatives();
+        benchmark::DoNotOptimize(paths.size());
+        benchmark::DoNotOptimize(paths.front());
+    }
+}
+BENCHMARK(BM_Alternatives)->Apply(corpusArguments)->Unit(benchmark::kMillisecond);
+
+// Printing the map with the paths found, into a discarded stream
+static void
+BM_Dump(benchmark::State &state) {
+    PathFinder finder;
+    prepare(state, finder, Strategy::A_STAR);
+    finder.solve();
+
+    std::stringstream sink;
+    auto             *previous = std::cout.rdbuf(sink.rdbuf());
+    for(auto _ : state) {
+        finder.dump();
+        sink.str(std::string());
+    }
+    std::cout.rdbuf(previous);
+    state.SetBytesProcessed(state.iterations() * (state.range(1) + 1) * state.range(1));
+}
+BENCHMARK(BM_Dump)->Apply(corpusArguments)->Unit(benchmark::kMillisecond);
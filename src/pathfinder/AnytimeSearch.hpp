@@ -0,0 +1,351 @@
+#pragma once
+
+#include <pathfinder/IndexedHeap.hpp>
+#include <pathfinder/SearchCore.hpp>
+#include <pathfinder/SearchStats.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace cam::pathfinder {
+
+/// @brief Anytime repairing A* (ARA*), finding a path quickly and improving it over as many runs as time allows.
+///
+/// Uses the same policy objects as SearchCore. Every iteration is a weighted A* whose heuristic is inflated by epsilon,
+/// so its path costs at most epsilon times the optimal one, and the next iteration lowers epsilon by STEP until it
+/// reaches 1. Iterations reuse the scores of the previous ones: nodes lowered after being expanded wait in an
+/// inconsistent list, and only they and the open nodes are searched again. Runs stop at a deadline or after a number of
+/// expansions, and the next run on the same query resumes where the previous one stopped, so calling it again keeps
+/// improving the path until it is optimal.
+/// @tparam Cost Type of the scores.
+template<typename Cost>
+class AnytimeSearch {
+public:
+    using Path = std::vector<uint32_t>;
+
+    static constexpr Cost   INFINITE = std::numeric_limits<Cost>::max();
+    static constexpr double STEP     = 0.5;    // epsilon decrease between iterations
+
+private:
+    struct Entry {
+        double   key;    // g plus the inflated heuristic
+        Cost     g;
+        uint32_t slot;
+
+        bool
+        operator>(const Entry &other) const {
+            return key > other.key || (key == other.key && g < other.g);
+        }
+    };
+
+    IndexedHeap<Entry>       openSet;
+    std::vector<uint32_t>    stamps;      // query that reached every slot
+    std::vector<Cost>        scores;
+    std::vector<int>         parents;
+    std::vector<uint32_t>    closedIn;    // iteration that expanded every slot
+    std::vector<uint32_t>    inconsIn;    // iteration whose inconsistent list holds every slot
+    std::vector<uint32_t>    incons;      // slots lowered after being expanded in this iteration
+    std::vector<uint32_t>    scratch;
+    uint32_t                 generation = 0;
+    uint32_t                 iteration  = 0;
+    Path                     found;
+    Cost                     best          = INFINITE;
+    double                   initial       = 1.5;
+    double                   epsilon       = 1.5;
+    double                   proven        = std::numeric_limits<double>::infinity();    // epsilon last proven
+    double                   suboptimality = std::numeric_limits<double>::infinity();
+    std::chrono::nanoseconds deadline{0};
+    uint64_t                 expansionLimit = 0;
+    bool                     active         = false;
+    bool                     finished       = false;
+    uint32_t                 startCell      = 0;
+    uint32_t                 goalCell       = 0;
+    int                      ndirs          = 1;
+    SearchStats             *stats          = nullptr;
+    const TraceCallback     *trace          = nullptr;
+
+    inline void
+    nextIteration() {
+        if(++iteration == 0) {
+            std::fill(closedIn.begin(), closedIn.end(), 0);
+            std::fill(inconsIn.begin(), inconsIn.end(), 0);
+            iteration = 1;
+        }
+    }
+
+    template<typename Policy>
+    inline double
+    key(const Policy &policy, uint32_t slot) const {
+        return scores[slot] + epsilon * policy.heuristic(slot / ndirs);
+    }
+
+    /// @brief Forgets the previous query and queues the start.
+    template<typename Policy>
+    void
+    begin(const Policy &policy, size_t cells, uint32_t start, uint32_t goal) {
+        ndirs = policy.directions();
+
+        const size_t size = cells * ndirs;
+        if(stamps.size() != size) {
+            stamps.assign(size, 0);
+            scores.resize(size);
+            parents.resize(size);
+            closedIn.assign(size, 0);
+            inconsIn.assign(size, 0);
+            generation = 0;
+        }
+        if(++generation == 0) {
+            std::fill(stamps.begin(), stamps.end(), 0);
+            generation = 1;
+        }
+        nextIteration();
+        openSet.reset(size);
+        incons.clear();
+        found.clear();
+        startCell     = start;
+        goalCell      = goal;
+        best          = INFINITE;
+        epsilon       = initial;
+        proven        = std::numeric_limits<double>::infinity();
+        suboptimality = std::numeric_limits<double>::infinity();
+        active        = true;
+        finished      = false;
+
+        if(start == goal) {
+            best     = 0;
+            finished = true;
+            found.push_back(goal);
+            return;
+        }
+        const uint32_t slot = start * ndirs;
+        stamps[slot]        = generation;
+        scores[slot]        = 0;
+        parents[slot]       = -1;
+        openSet.push(slot, {key(policy, slot), 0, slot});
+    }
+
+    /// @brief Requeues the open and inconsistent nodes with the keys of the current epsilon, for the next iteration.
+    template<typename Policy>
+    void
+    reopen(const Policy &policy) {
+        scratch.assign(incons.begin(), incons.end());
+        openSet.forEach([this](uint32_t slot, const Entry &) { scratch.push_back(slot); });
+        incons.clear();
+        nextIteration();
+        openSet.reset(stamps.size());
+        for(uint32_t slot : scratch) {
+            openSet.push(slot, {key(policy, slot), scores[slot], slot});
+        }
+    }
+
+    /// @brief Lowest bound of the optimal cost: every optimal path has a node with its optimal score either open or
+    /// inconsistent, so none costs less than the lowest g + h among them.
+    template<typename Policy>
+    double
+    lowerBound(const Policy &policy) const {
+        double lower = std::numeric_limits<double>::infinity();
+        openSet.forEach([&](uint32_t slot, const Entry &entry) {
+            lower = std::min(lower, (double)entry.g + policy.heuristic(slot / ndirs));
+        });
+        for(uint32_t slot : incons) {
+            lower = std::min(lower, (double)scores[slot] + policy.heuristic(slot / ndirs));
+        }
+        return lower;
+    }
+
+    /// @brief Keeps the path reaching the goal from a slot, as soon as it is the best one, and its cost. Later
+    /// expansions move the parents of the slots on it, so the chain may not lead along this path by the end of the run.
+    /// Scores lowered since they were passed down the chain may already make it cheaper, so its cost is added up again.
+    template<typename Policy>
+    void
+    keep(const Policy &policy, uint32_t parent, int dir) {
+        scratch.clear();
+        for(int slot = parent; slot >= 0; slot = parents[slot]) {
+            scratch.push_back(slot);
+        }
+        std::reverse(scratch.begin(), scratch.end());
+
+        found.clear();
+        SearchNode<Cost> from{0, 0, startCell, 0, -1};
+        for(size_t idx = 1; idx <= scratch.size(); idx++) {
+            const uint32_t next = idx < scratch.size() ? scratch[idx] / ndirs : goalCell;
+            const int      move = idx < scratch.size() ? (int)(scratch[idx] % ndirs) : dir;
+            found.push_back(from.cell);
+            from = {0, policy.step(from, next, move), next, move, (int)scratch[idx - 1]};
+        }
+        found.push_back(goalCell);
+        best = from.g;
+    }
+
+public:
+    /// @brief Collects statistics of the next runs, see SearchCore::instrument().
+    inline void
+    instrument(SearchStats *stats, const TraceCallback *trace = nullptr) {
+        this->stats = stats;
+        this->trace = trace;
+    }
+
+    /// @brief Sets the inflation of the first iteration of the next queries, at least 1.
+    inline void
+    setEpsilon(double epsilon) {
+        initial = std::max(epsilon, 1.0);
+    }
+
+    /// @brief Limits every run to a wall time and a number of expansions, zero meaning no limit. Without any limit a
+    /// run goes on until the path is optimal. Whatever the deadline, a run expands 16 nodes before giving up.
+    inline void
+    setLimits(std::chrono::nanoseconds deadline, uint64_t expansions) {
+        this->deadline = deadline;
+        expansionLimit = expansions;
+    }
+
+    /// @brief Makes the next run start over even for the same query, to call once the map changed.
+    inline void
+    restart() {
+        active = false;
+    }
+
+    /// @brief Memory held by the search buffers, in bytes.
+    inline size_t
+    bytes() const {
+        return openSet.bytes() + (stamps.capacity() + closedIn.capacity() + inconsIn.capacity() + incons.capacity() + scratch.capacity()) * sizeof(uint32_t) +
+               scores.capacity() * sizeof(Cost) + parents.capacity() * sizeof(int) + found.capacity() * sizeof(uint32_t);
+    }
+
+    /// @brief Searches or improves a path between two cells, within the limits. The search of the previous run resumes
+    /// if the query is the same and restart() wasn't called.
+    /// @param policy Map specific operations, see SearchCore.
+    /// @param cells Number of cell ids of the map.
+    /// @param start Cell id where the search starts.
+    /// @param goal Cell id to reach.
+    /// @return True if a path is known, possibly found by a previous run.
+    template<typename Policy>
+    bool
+    run(const Policy &policy, size_t cells, uint32_t start, uint32_t goal) {
+        if(!active || start != startCell || goal != goalCell || stamps.size() != cells * policy.directions()) {
+            begin(policy, cells, start, goal);
+        }
+
+        if(!finished) {
+            if(stats == nullptr) {
+                advance(SearchProbe<false>(nullptr, nullptr), policy);
+            } else {
+                measure(stats, &SearchStats::searchTime, [&]() { advance(SearchProbe<true>(stats, trace), policy); });
+            }
+        }
+        suboptimality = best == INFINITE ? std::numeric_limits<double>::infinity()
+                        : finished       ? 1.0
+                                         : std::max(1.0, std::min(proven, best / lowerBound(policy)));
+        if(stats != nullptr) {
+            stats->bytes = bytes();
+        }
+        return best != INFINITE;
+    }
+
+    /// @brief Best path known for the query, as a list of cell ids from start to goal.
+    inline const Path &
+    path() const {
+        return found;
+    }
+
+    /// @brief Cost of the best path known, INFINITE if none was found yet.
+    inline Cost
+    cost() const {
+        return best;
+    }
+
+    /// @brief Suboptimality bound of the best path known: its cost is at most this many times the optimal one. Infinity
+    /// while no path is known, 1 once it is optimal.
+    inline double
+    bound() const {
+        return suboptimality;
+    }
+
+    /// @brief True once the path is proven optimal, further runs on the same query do nothing.
+    inline bool
+    isFinished() const {
+        return finished;
+    }
+
+private:
+    /// @brief Runs iterations until the path is optimal or a limit is reached.
+    template<typename Probe, typename Policy>
+    void
+    advance(Probe probe, const Policy &policy) {
+        const auto begin      = std::chrono::steady_clock::now();
+        uint64_t   expansions = 0;
+        while(improve(probe, policy, begin, expansions)) {
+            proven = epsilon;
+            if(epsilon <= 1.0) {
+                finished = true;
+                return;
+            }
+            epsilon = std::max(1.0, epsilon - STEP);
+            reopen(policy);
+        }
+    }
+
+    /// @brief Expands nodes until none can lead to a cheaper path with the current epsilon.
+    /// @return False if a limit stopped the iteration first.
+    template<typename Probe, typename Policy>
+    bool
+    improve(Probe &probe, const Policy &policy, std::chrono::steady_clock::time_point begin, uint64_t &expansions) {
+        while(!openSet.empty() && openSet.top().key < best) {
+            if(expansionLimit > 0 && expansions >= expansionLimit) {
+                return false;
+            }
+            // Reading the clock costs more than a few expansions, so the deadline is checked every 16 of them. The
+            // first ones are always done, so runs make progress even with a deadline shorter than a clock read.
+            if(deadline.count() > 0 && expansions > 0 && expansions % 16 == 0 && std::chrono::steady_clock::now() - begin >= deadline) {
+                return false;
+            }
+
+            const Entry    current = openSet.pop();
+            const uint32_t cell    = current.slot / ndirs;
+            const SearchNode<Cost> from{(Cost)current.key, current.g, cell, (int)(current.slot % ndirs), parents[current.slot]};
+            closedIn[current.slot] = iteration;
+            expansions++;
+            probe.pop();
+            probe.expand(cell);
+
+            for(int idx = 0; idx < ndirs; idx++) {
+                const uint32_t next = cell + policy.offset(idx);
+                if(!policy.canMove(cell, next, idx)) {
+                    continue;
+                }
+
+                // Nodes that can't beat the best path known are never queued
+                const Cost tentativeG = policy.step(from, next, idx);
+                if(tentativeG >= best || tentativeG + policy.heuristic(next) >= best) {
+                    continue;
+                }
+                if(next == goalCell) {
+                    keep(policy, current.slot, idx);
+                    continue;
+                }
+
+                const uint32_t slot = next * ndirs + idx;
+                if(stamps[slot] == generation && scores[slot] <= tentativeG) {
+                    probe.skip();
+                    continue;
+                }
+                stamps[slot]  = generation;
+                scores[slot]  = tentativeG;
+                parents[slot] = current.slot;
+                if(closedIn[slot] != iteration) {
+                    openSet.push(slot, {key(policy, slot), tentativeG, slot});
+                    probe.push(openSet.size());
+                } else if(inconsIn[slot] != iteration) {
+                    inconsIn[slot] = iteration;
+                    incons.push_back(slot);
+                }
+            }
+        }
+        return true;
+    }
+};
+
+}    // namespace cam::pathfinder
@@ -0,0 +1,308 @@
+#pragma once
+
+#include <math/Vector2.hpp>
+#include <pathfinder/ConnectedComponents.hpp>
+#include <pathfinder/Grid.hpp>
+#include <pathfinder/PathDag.hpp>
+#include <pathfinder/Policies.hpp>
+#include <pathfinder/QuerySolver.hpp>
+#include <pathfinder/SearchStats.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cam::pathfinder {
+
+/// @brief Path finder whose map, moves, costs and heuristic are compile-time policies (see Policies.hpp).
+///
+/// Offers the same operations as PathFinder without any virtual call, so the compiler inlines the policies in the
+/// search loops. The map is given already built instead of parsed. Moves must be reversible, as queries between regions
+/// of the map no move joins are rejected without searching (see ConnectedComponents).
+/// @tparam Map Grid like type.
+/// @tparam Neighborhood Moves allowed from every cell.
+/// @tparam Cost Score type and score of every move.
+/// @tparam Heuristic Admissible estimation of the cost to the goal.
+template<typename Map = Grid, typename Neighborhood = FourNeighborhood, typename Cost = UnitCost, typename Heuristic = ManhattanHeuristic>
+class BasicPathFinder {
+public:
+    using Score = typename Cost::Score;
+    using Path  = std::vector<math::Vector2i>;
+    using Paths = OptimalPaths<math::Vector2i>;
+
+protected:
+    Map                                                         map;
+    uint32_t                                                    startCell = 0;
+    uint32_t                                                    endCell   = 0;
+    Strategy                                                    strategy  = Strategy::A_STAR;
+    Path                                                        solution;
+    mutable std::shared_ptr<const PathDag>                      optimalPaths;
+    mutable bool                                                pendingAlternatives = false;
+    Score                                                       minCost             = SearchCore<Score>::INFINITE;
+    double                                                      costBound           = std::numeric_limits<double>::infinity();
+    mutable BasicQuerySolver<Map, Neighborhood, Cost, Heuristic> solver;
+    mutable ConnectedComponents<Neighborhood>                   components;
+    mutable SearchStats                                         searchStats;
+    bool                                                        statsEnabled = false;
+    TraceCallback                                               trace;
+
+    /// @brief Points the solver to the statistics right before searching, so copies of the finder never share them.
+    inline void
+    instrument() const {
+        const bool enabled = statsEnabled || trace;
+        solver.instrument(enabled ? &searchStats : nullptr, enabled && trace ? &trace : nullptr);
+    }
+
+    /// @brief Relabels the stale regions after a search found no path, as that search already cost as much.
+    inline void
+    searchFailed() const {
+        if(components.isStale()) {
+            components.build(map);
+        }
+    }
+
+    Path
+    positions(const std::vector<uint32_t> &cells) const {
+        Path path;
+        path.reserve(cells.size());
+        for(uint32_t cell : cells) {
+            path.push_back(map.position(cell));
+        }
+        return path;
+    }
+
+    /// @brief Searches the graph of equivalent paths, bounded by the given cost.
+    /// @return The optimal cost, INFINITE if there is no path.
+    Score
+    searchEquivalents(Score bound) const {
+        optimalPaths.reset();
+        pendingAlternatives = false;
+        if(startCell == 0 || endCell == 0 || !components.connected(startCell, endCell)) {
+            return SearchCore<Score>::INFINITE;
+        }
+
+        Score cost;
+        instrument();
+        if(const PathDag *dag = solver.searchEquivalents(map, startCell, endCell, cost, bound); dag != nullptr) {
+            optimalPaths = std::make_shared<const PathDag>(*dag);
+        } else {
+            searchFailed();
+        }
+        return cost;
+    }
+
+public:
+    explicit BasicPathFinder(Neighborhood neighborhood = {}, Cost costs = {}, Heuristic heuristic = {})
+        : solver(neighborhood, std::move(costs), std::move(heuristic)), components(std::move(neighborhood)) {
+    }
+
+    /// @brief Replaces the map, looking for its START and END cells, and labels its regions.
+    void
+    set(Map map) {
+        this->map = std::move(map);
+        startCell = this->map.find(START);
+        endCell   = this->map.find(END);
+        components.build(this->map);
+        solver.restart();
+        solution.clear();
+        optimalPaths.reset();
+        pendingAlternatives = false;
+        minCost             = SearchCore<Score>::INFINITE;
+        costBound           = std::numeric_limits<double>::infinity();
+    }
+
+    /// @brief Changes a cell of the map, see PathFinder::updateCell().
+    void
+    updateCell(int x, int y, Type type) {
+        if(!map.inside(x, y)) {
+            return;
+        }
+
+        const uint32_t cell       = map.index(x, y);
+        const bool     wasBlocked = map.isBlocked(cell);
+        if(type == START || type == END) {
+            uint32_t &endpoint = type == START ? startCell : endCell;
+            if(endpoint != 0 && endpoint != cell) {
+                map.set(endpoint, EMPTY);
+            }
+            endpoint = cell;
+        }
+        if(cell == startCell && type != START) {
+            startCell = 0;
+        }
+        if(cell == endCell && type != END) {
+            endCell = 0;
+        }
+        map.set(cell, type);
+        if(wasBlocked != map.isBlocked(cell)) {
+            components.update(map, cell);
+        }
+        solver.restart();
+
+        solution.clear();
+        optimalPaths.reset();
+        pendingAlternatives = false;
+        minCost             = SearchCore<Score>::INFINITE;
+        costBound           = std::numeric_limits<double>::infinity();
+    }
+
+    inline void
+    setStrategy(Strategy strategy) {
+        this->strategy = strategy;
+    }
+
+    /// @brief Sets the memory of every search of the memory bounded strategies, see PathFinder::setMemoryBudget().
+    inline void
+    setMemoryBudget(size_t bytes) {
+        solver.setMemoryBudget(bytes);
+    }
+
+    /// @brief Limits every search of the ANYTIME strategy, see PathFinder::setAnytimeLimits().
+    inline void
+    setAnytimeLimits(std::chrono::nanoseconds deadline, uint64_t expansions = 0) {
+        solver.setAnytimeLimits(deadline, expansions);
+    }
+
+    inline const Map &
+    getMap() const {
+        return map;
+    }
+
+    /// @brief Collects statistics of the searches, see stats(). Disabled searches run without any instrumentation.
+    inline void
+    setStatsEnabled(bool enabled) {
+        statsEnabled = enabled;
+    }
+
+    /// @brief Reports every expansion of the next searches, collecting statistics too. An empty callback removes it.
+    inline void
+    setTrace(TraceCallback trace) {
+        this->trace = std::move(trace);
+    }
+
+    /// @brief Statistics of the last solve() or solveBatch(), including the equivalent paths searched afterwards.
+    inline const SearchStats &
+    stats() const {
+        return searchStats;
+    }
+
+    /// @brief Searches an optimal path from START to END. A_STAR lists every equivalent path at once, the other
+    /// strategies search them only if alternatives() is called.
+    Path
+    solve() {
+        solution.clear();
+        optimalPaths.reset();
+        pendingAlternatives = false;
+        minCost             = SearchCore<Score>::INFINITE;
+        costBound           = std::numeric_limits<double>::infinity();
+        searchStats.reset();
+        if(startCell == 0 || endCell == 0) {
+            return solution;
+        }
+
+        instrument();
+        if(strategy == Strategy::A_STAR) {
+            minCost   = searchEquivalents(SearchCore<Score>::INFINITE);
+            solution  = alternatives().front();
+            costBound = solution.empty() ? costBound : 1.0;
+        } else if(!components.connected(startCell, endCell)) {
+            return solution;
+        } else if(const auto *cells = solver.search(map, strategy, startCell, endCell, minCost); cells != nullptr) {
+            solution            = positions(*cells);
+            costBound           = solver.bound();
+            pendingAlternatives = true;
+        } else {
+            searchFailed();
+        }
+        return solution;
+    }
+
+    /// @brief Every optimal path of the last solve, enumerated lazily.
+    Paths
+    alternatives() const {
+        if(pendingAlternatives) {
+            searchEquivalents(minCost);
+        }
+        return Paths(optimalPaths, map.getStride());
+    }
+
+    /// @brief Cost of the last solved path, INFINITE if there was none.
+    inline Score
+    cost() const {
+        return minCost;
+    }
+
+    /// @brief Suboptimality bound of the last solved path, see PathFinder::bound().
+    inline double
+    bound() const {
+        return costBound;
+    }
+
+    /// @brief Solves several queries on the current map, one optimal path each, sharing the search buffers.
+    /// @param results Output, resized to the number of queries. The paths already stored in it are reused.
+    void
+    solveBatch(const std::vector<Query> &queries, std::vector<QueryResult> &results) {
+        results.resize(queries.size());
+        searchStats.reset();
+        instrument();
+        for(size_t idx = 0; idx < queries.size(); idx++) {
+            const auto &[from, to] = queries[idx];
+            if(map.inside(from.getX(), from.getY()) && map.inside(to.getX(), to.getY()) &&
+               !components.connected(map.index(from.getX(), from.getY()), map.index(to.getX(), to.getY()))) {
+                results[idx].path.clear();
+                results[idx].cost  = std::numeric_limits<double>::max();
+                results[idx].bound = std::numeric_limits<double>::infinity();
+                continue;
+            }
+            solver.solve(map, strategy, queries[idx], results[idx]);
+            if(results[idx].path.empty()) {
+                searchFailed();
+            }
+        }
+    }
+
+    std::vector<QueryResult>
+    solveBatch(const std::vector<Query> &queries) {
+        std::vector<QueryResult> results;
+        solveBatch(queries, results);
+        return results;
+    }
+
+    /// @brief Prints the map with the solution marked with '+' and the rest of equivalent paths with 'x'.
+    void
+    dump() const {
+        if(pendingAlternatives) {
+            searchEquivalents(minCost);
+        }
+
+        const size_t   LINE  = map.getWidth() + 1;
+        const PathDag *paths = optimalPaths.get();
+
+        // Every row is written in place into a single buffer, already holding the line endings, and printed at once
+        std::string out(1 + LINE * map.getHeight(), '\n');
+        for(int y = 0; y < map.getHeight(); y++) {
+            char *line = &out[1 + y * LINE];
+            for(int x = 0; x < map.getWidth(); x++) {
+                const uint32_t cell = map.index(x, y);
+                line[x]             = map.isBlocked(cell) ? '#' : paths != nullptr && paths->onPath(cell) ? 'x' : '.';
+            }
+        }
+        for(const auto &pos : solution) {
+            out[1 + (size_t)pos.getY() * LINE + (size_t)pos.getX()] = '+';
+        }
+        std::cout.write(out.data(), out.size());
+    }
+};
+
+/// @brief Path finder with diagonal moves, never cutting the corner of a blocked cell unless its neighborhood is told.
+using OctilePathFinder = BasicPathFinder<Grid, EightNeighborhood, OctileCost<>, OctileHeuristic<>>;
+
+/// @brief Path finder for hexagonal maps in axial coordinates, see HexNeighborhood.
+using HexPathFinder = BasicPathFinder<Grid, HexNeighborhood, TerrainCost, HexHeuristic>;
+
+}    // namespace cam::pathfinder
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <pathfinder/OpenSet.hpp>
+#include <pathfinder/SearchCore.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace cam::pathfinder {
+
+/// @brief Bidirectional A* that searches from the start and the goal at the same time.
+///
+/// Uses the same policy objects as SearchCore. The forward policy provides the moves, their costs and the estimation to
+/// the goal; the backward policy only provides the estimation to the start. Moves are assumed to be reversible with the
+/// same cost, and step() must add the cost of the move to the given score.
+///
+/// Each step expands the side with the smaller open set. The search stops once the lowest f of either side is not below
+/// the best path found meeting both searches: with consistent heuristics each side's lowest f is a lower bound of any
+/// path still to be found, so that path is optimal.
+/// @tparam Cost Type of the scores.
+template<typename Cost>
+class BidirectionalSearch {
+public:
+    using Path = std::vector<uint32_t>;
+
+    static constexpr Cost     INFINITE = std::numeric_limits<Cost>::max();
+    static constexpr uint32_t NONE     = std::numeric_limits<uint32_t>::max();
+
+private:
+    struct Entry {
+        Cost     f;
+        Cost     g;
+        uint32_t cell;
+
+        bool
+        operator>(const Entry &other) const {
+            return f > other.f || (f == other.f && g < other.g);
+        }
+    };
+
+    struct Side {
+        OpenSet<Entry>        openSet;    // keyed by cell
+        std::vector<uint32_t> stamps;    // generation when the cell was reached, closed cells store its complement
+        std::vector<Cost>     scores;
+        std::vector<uint32_t> parents;
+
+        void
+        reset(size_t cells, uint32_t generation) {
+            if(stamps.size() != cells) {
+                stamps.assign(cells, 0);
+                scores.resize(cells);
+                parents.resize(cells);
+            }
+            if(generation == 1) {
+                std::fill(stamps.begin(), stamps.end(), 0);
+            }
+            openSet.reset(cells);
+        }
+
+        inline bool
+        reached(uint32_t cell, uint32_t generation) const {
+            return stamps[cell] == generation || stamps[cell] == ~generation;
+        }
+        inline bool
+        closed(uint32_t cell, uint32_t generation) const {
+            return stamps[cell] == ~generation;
+        }
+        inline Cost
+        top() const {
+            return openSet.empty() ? INFINITE : openSet.top().f;
+        }
+    };
+
+    Side                 sides[2];
+    uint32_t             generation = 0;
+    Path                 found;
+    Cost                 best     = INFINITE;
+    uint32_t             meeting  = NONE;
+    size_t               expanded = 0;
+    SearchStats         *stats    = nullptr;
+    const TraceCallback *trace    = nullptr;
+
+    std::vector<int> reverse;    // direction index of the opposite move
+
+    template<typename Probe, typename Policy>
+    void
+    expand(Probe &probe, const Policy &forward, const Policy &estimation, int index) {
+        Side       &side  = sides[index];
+        const Side &other = sides[1 - index];
+
+        Entry current = side.openSet.pop();
+        side.stamps[current.cell] = ~generation;
+        expanded++;
+        probe.pop();
+        probe.expand(current.cell);
+
+        SearchNode<Cost> node = {current.f, current.g, current.cell, 0, -1};
+        SearchNode<Cost> zero = {0, 0, 0, 0, -1};
+        for(int idx = 0; idx < forward.directions(); idx++) {
+            const uint32_t next = current.cell + forward.offset(idx);
+
+            // The backward side walks the moves in reverse: the allowed move and its cost are the ones into the cell.
+            Cost tentativeG;
+            if(index == 0) {
+                if(!forward.canMove(current.cell, next, idx)) {
+                    continue;
+                }
+                tentativeG = forward.step(node, next, idx);
+            } else {
+                if(!forward.canMove(next, current.cell, reverse[idx])) {
+                    continue;
+                }
+                zero.cell  = next;
+                tentativeG = current.g + forward.step(zero, current.cell, reverse[idx]);
+            }
+
+            if(side.closed(next, generation) || (side.reached(next, generation) && side.scores[next] <= tentativeG)) {
+                probe.skip();
+                continue;
+            }
+            side.stamps[next]  = generation;
+            side.scores[next]  = tentativeG;
+            side.parents[next] = current.cell;
+            side.openSet.push(next, {tentativeG + estimation.heuristic(next), tentativeG, next});
+            probe.push(side.openSet.size() + other.openSet.size());
+
+            if(other.reached(next, generation) && tentativeG + other.scores[next] < best) {
+                best    = tentativeG + other.scores[next];
+                meeting = next;
+            }
+        }
+    }
+
+    template<typename Probe, typename Policy>
+    void
+    search(Probe probe, const Policy &forward, const Policy &backward) {
+        probe.push(2);
+        probe.push(2);
+        while(!sides[0].openSet.empty() && !sides[1].openSet.empty()) {
+            if(std::max(sides[0].top(), sides[1].top()) >= best) {
+                break;
+            }
+            if(sides[0].openSet.size() <= sides[1].openSet.size()) {
+                expand(probe, forward, forward, 0);
+            } else {
+                expand(probe, forward, backward, 1);
+            }
+        }
+    }
+
+    void
+    rebuild(uint32_t start, uint32_t goal) {
+        found.clear();
+        for(uint32_t cell = meeting; cell != start; cell = sides[0].parents[cell]) {
+            found.push_back(cell);
+        }
+        found.push_back(start);
+        std::reverse(found.begin(), found.end());
+        for(uint32_t cell = meeting; cell != goal;) {
+            cell = sides[1].parents[cell];
+            found.push_back(cell);
+        }
+    }
+
+public:
+    /// @brief Collects statistics of the next runs, see SearchCore::instrument().
+    inline void
+    instrument(SearchStats *stats, const TraceCallback *trace = nullptr) {
+        this->stats = stats;
+        this->trace = trace;
+    }
+
+    /// @brief Memory held by the search buffers of both sides, in bytes.
+    size_t
+    bytes() const {
+        size_t total = found.capacity() * sizeof(uint32_t) + reverse.capacity() * sizeof(int);
+        for(const Side &side : sides) {
+            total += side.openSet.bytes() + (side.stamps.capacity() + side.parents.capacity()) * sizeof(uint32_t) + side.scores.capacity() * sizeof(Cost);
+        }
+        return total;
+    }
+
+    /// @brief Searches an optimal path between two cells.
+    /// @param forward Policy with the moves and the estimation to the goal.
+    /// @param backward Policy with the estimation to the start.
+    /// @param cells Number of cell ids of the map.
+    /// @param start Cell id where the search starts.
+    /// @param goal Cell id to reach.
+    /// @return True if the goal was reached.
+    template<typename Policy>
+    bool
+    run(const Policy &forward, const Policy &backward, size_t cells, uint32_t start, uint32_t goal) {
+        // Generations stay below 2^31, so their complements used for closed cells never collide with them
+        if(++generation >= 0x80000000u) {
+            generation = 1;
+        }
+        sides[0].reset(cells, generation);
+        sides[1].reset(cells, generation);
+        found.clear();
+        best     = INFINITE;
+        meeting  = NONE;
+        expanded = 0;
+
+        reverse.assign(forward.directions(), 0);
+        for(int idx = 0; idx < forward.directions(); idx++) {
+            for(int opposite = 0; opposite < forward.directions(); opposite++) {
+                if(forward.offset(opposite) == -forward.offset(idx)) {
+                    reverse[idx] = opposite;
+                }
+            }
+        }
+
+        const Cost zero = 0;
+        for(int index = 0; index < 2; index++) {
+            const uint32_t cell = index == 0 ? start : goal;
+            sides[index].stamps[cell]  = generation;
+            sides[index].scores[cell]  = zero;
+            sides[index].parents[cell] = cell;
+            sides[index].openSet.push(cell, {(index == 0 ? forward : backward).heuristic(cell), zero, cell});
+        }
+        if(start == goal) {
+            best    = zero;
+            meeting = start;
+        }
+
+        if(stats == nullptr) {
+            search(SearchProbe<false>(nullptr, nullptr), forward, backward);
+        } else {
+            measure(stats, &SearchStats::searchTime, [&]() { search(SearchProbe<true>(stats, trace), forward, backward); });
+        }
+
+        const bool reached = meeting != NONE;
+        if(reached) {
+            measure(stats, &SearchStats::pathTime, [&]() { rebuild(start, goal); });
+        }
+        if(stats != nullptr) {
+            stats->bytes = bytes();
+        }
+        return reached;
+    }
+
+    /// @brief Path found by the last run, as a list of cell ids from start to goal.
+    inline const Path &
+    path() const {
+        return found;
+    }
+
+    /// @brief Cost of the path found by the last run, INFINITE if the goal wasn't reached.
+    inline Cost
+    cost() const {
+        return best;
+    }
+
+    /// @brief Number of cells expanded by both sides during the last run.
+    inline size_t
+    expansions() const {
+        return expanded;
+    }
+};
+
+}    // namespace cam::pathfinder
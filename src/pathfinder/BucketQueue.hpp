@@ -0,0 +1,227 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace cam::pathfinder {
+
+/// @brief Dial's bucket queue: items keyed by an integer id, with one bucket per integral priority.
+///
+/// Offers the same interface as IndexedHeap, with O(1) push, decrease-key and pop as long as the priorities stay
+/// integral and the queued ones span a bounded range. The buckets form a ring indexed by the priority, which grows when
+/// the span of queued priorities does, up to MAX_SPAN. Use fits() before pushing to know if the item can be queued.
+///
+/// Items are popped by lowest `f` only. Within a bucket the last item pushed is popped first, which keeps the search
+/// going deep along equal priorities as the heap tie-breaking does.
+/// @tparam Item Queued value, with a public member `f` holding its priority.
+template<typename Item>
+class BucketQueue {
+public:
+    static constexpr int64_t MAX_SPAN = 1 << 16;
+
+private:
+    struct Entry {
+        Item     item;
+        uint32_t key;
+    };
+
+    std::vector<std::vector<Entry>> buckets;
+    std::vector<uint32_t>           positions;    // index of every queued key inside its bucket
+    std::vector<uint32_t>           rings;        // bucket of every queued key
+    std::vector<uint32_t>           stamps;       // generation of every queued key, 0 once popped
+    uint32_t                        generation = 0;
+    size_t                          count      = 0;
+    mutable int64_t                 lowest     = 0;    // no item is queued below it
+    int64_t                         highest    = 0;    // no item is queued above it
+
+    static inline int64_t
+    priority(const Item &item) {
+        return static_cast<int64_t>(item.f);
+    }
+
+    inline size_t
+    ring(int64_t f) const {
+        return static_cast<size_t>(f) & (buckets.size() - 1);
+    }
+
+    inline void
+    insert(uint32_t key, const Item &item) {
+        auto &bucket   = buckets[ring(priority(item))];
+        stamps[key]    = generation;
+        rings[key]     = ring(priority(item));
+        positions[key] = bucket.size();
+        bucket.push_back({item, key});
+        count++;
+    }
+
+    inline void
+    remove(uint32_t key) {
+        auto &bucket = buckets[rings[key]];
+        if(positions[key] + 1 != bucket.size()) {
+            bucket[positions[key]]                = bucket.back();
+            positions[bucket[positions[key]].key] = positions[key];
+        }
+        bucket.pop_back();
+        stamps[key] = 0;
+        count--;
+    }
+
+    /// @brief Grows the ring so the given span of priorities fits, moving every queued item to its new bucket.
+    void
+    grow(int64_t span) {
+        size_t size = buckets.size();
+        while(static_cast<int64_t>(size) < span) {
+            size *= 2;
+        }
+
+        std::vector<Entry> queued;
+        for(auto &bucket : buckets) {
+            queued.insert(queued.end(), bucket.begin(), bucket.end());
+            bucket.clear();
+        }
+        buckets.resize(size);
+        count = 0;
+        for(const Entry &entry : queued) {
+            insert(entry.key, entry.item);
+        }
+    }
+
+    /// @brief Moves the lowest bound to the first bucket with items.
+    inline void
+    settle() const {
+        while(buckets[ring(lowest)].empty()) {
+            lowest++;
+        }
+    }
+
+public:
+    BucketQueue() : buckets(64) {}
+
+    /// @brief Empties the queue and makes room for the given number of keys.
+    void
+    reset(size_t keys) {
+        for(auto &bucket : buckets) {
+            bucket.clear();
+        }
+        count = 0;
+        if(stamps.size() != keys) {
+            stamps.assign(keys, 0);
+            positions.resize(keys);
+            rings.resize(keys);
+            generation = 0;
+        }
+        if(++generation == 0) {
+            std::fill(stamps.begin(), stamps.end(), 0);
+            generation = 1;
+        }
+    }
+
+    /// @brief Checks if the item can be queued: its priority is integral and keeps the queued span within MAX_SPAN.
+    inline bool
+    fits(const Item &item) const {
+        if constexpr(std::is_floating_point_v<decltype(item.f)>) {
+            if(!(std::fabs(item.f) < 9007199254740992.0) || item.f != std::floor(item.f)) {
+                return false;
+            }
+        }
+        if(count == 0) {
+            return true;
+        }
+        const int64_t f = priority(item);
+        return std::max(highest, f) - std::min(lowest, f) < MAX_SPAN;
+    }
+
+    inline bool
+    empty() const {
+        return count == 0;
+    }
+
+    inline size_t
+    size() const {
+        return count;
+    }
+
+    /// @brief Memory held by the queue, in bytes.
+    size_t
+    bytes() const {
+        size_t total = buckets.capacity() * sizeof(std::vector<Entry>);
+        for(const auto &bucket : buckets) {
+            total += bucket.capacity() * sizeof(Entry);
+        }
+        return total + (positions.capacity() + rings.capacity() + stamps.capacity()) * sizeof(uint32_t);
+    }
+
+    /// @brief Checks if the key is waiting in the queue.
+    inline bool
+    contains(uint32_t key) const {
+        return stamps[key] == generation;
+    }
+
+    /// @brief Item queued for a key, only valid if the key is contained.
+    inline const Item &
+    get(uint32_t key) const {
+        return buckets[rings[key]][positions[key]].item;
+    }
+
+    /// @brief Queues an item, or lowers the one already queued for the same key. The item must fit.
+    /// @return True if the queue changed, false if the key was already queued with an item not greater than this one.
+    bool
+    push(uint32_t key, const Item &item) {
+        if(contains(key)) {
+            if(!(get(key) > item)) {
+                return false;
+            }
+            remove(key);
+        }
+
+        const int64_t f = priority(item);
+        if(count == 0) {
+            lowest = highest = f;
+        } else {
+            lowest  = std::min(lowest, f);
+            highest = std::max(highest, f);
+        }
+        if(highest - lowest >= static_cast<int64_t>(buckets.size())) {
+            grow(highest - lowest + 1);
+        }
+        insert(key, item);
+        return true;
+    }
+
+    inline const Item &
+    top() const {
+        settle();
+        return buckets[ring(lowest)].back().item;
+    }
+
+    /// @brief Empties the queue handing every queued key and item to a callback, in no particular order.
+    template<typename Callback>
+    void
+    drain(Callback &&callback) {
+        for(auto &bucket : buckets) {
+            for(const Entry &entry : bucket) {
+                stamps[entry.key] = 0;
+                callback(entry.key, entry.item);
+            }
+            bucket.clear();
+        }
+        count = 0;
+    }
+
+    /// @brief Removes the lowest item. Its key can be queued again afterwards.
+    Item
+    pop() {
+        settle();
+        auto &bucket = buckets[ring(lowest)];
+        Item  item   = bucket.back().item;
+        stamps[bucket.back().key] = 0;
+        bucket.pop_back();
+        count--;
+        return item;
+    }
+};
+
+}    // namespace cam::pathfinder
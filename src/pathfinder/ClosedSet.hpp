@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace cam::pathfinder {
+
+/// @brief Set of cells already expanded by a search, together with the score they were first expanded with.
+///
+/// Every cell keeps the generation of the search that closed it, so starting a new search is a counter increment
+/// instead of clearing the whole map. Lookups and insertions are O(1).
+/// @tparam Cost Type of the score stored for every closed cell.
+template<typename Cost>
+class ClosedSet {
+    std::vector<uint32_t> stamps;
+    std::vector<Cost>     scores;
+    uint32_t              generation = 0;
+
+public:
+    /// @brief Empties the set and makes room for the given number of cells.
+    void
+    reset(size_t size) {
+        if(stamps.size() != size) {
+            stamps.assign(size, 0);
+            scores.resize(size);
+            generation = 0;
+        }
+        if(++generation == 0) {
+            std::fill(stamps.begin(), stamps.end(), 0);
+            generation = 1;
+        }
+    }
+
+    inline bool
+    contains(size_t cell) const {
+        return stamps[cell] == generation;
+    }
+
+    /// @brief Marks a cell as closed. Only the first score a cell is closed with is kept.
+    inline void
+    close(size_t cell, Cost score) {
+        if(stamps[cell] != generation) {
+            stamps[cell] = generation;
+            scores[cell] = score;
+        }
+    }
+
+    /// @brief Checks if a cell was closed with a score strictly lower than the given one.
+    inline bool
+    closedBelow(size_t cell, Cost score) const {
+        return stamps[cell] == generation && scores[cell] < score;
+    }
+
+    inline Cost
+    score(size_t cell) const {
+        return scores[cell];
+    }
+
+    inline size_t
+    size() const {
+        return stamps.size();
+    }
+
+    /// @brief Memory held by the set, in bytes.
+    inline size_t
+    bytes() const {
+        return stamps.capacity() * sizeof(uint32_t) + scores.capacity() * sizeof(Cost);
+    }
+};
+
+}    // namespace cam::pathfinder
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <pathfinder/Grid.hpp>
+#include <pathfinder/Policies.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace cam::pathfinder {
+
+/// @brief Regions of a map joined by the moves of a neighborhood, so a query between two regions is rejected in O(1)
+/// instead of flooding the whole region of the start.
+///
+/// Regions are labeled by a flood fill and kept as a union-find forest over the cell ids. Opening a cell merges the
+/// regions around it in place. Blocking a cell may split its region, which a union-find can't undo, so the labels are
+/// kept as they are: two cells with different labels are still never connected, and the labels are only marked stale
+/// until build() is called again. Moves must be reversible.
+/// @tparam Neighborhood Moves joining the cells, see Policies.hpp.
+template<typename Neighborhood = FourNeighborhood>
+class ConnectedComponents {
+    Neighborhood                  neighborhood;
+    mutable std::vector<uint32_t> parents;    // union-find forest over the cell ids, 0 for cells blocked at the build
+    std::vector<uint32_t>         queue;
+    bool                          stale = false;
+
+    inline uint32_t
+    find(uint32_t cell) const {
+        while(parents[cell] != cell) {
+            parents[cell] = parents[parents[cell]];
+            cell          = parents[cell];
+        }
+        return cell;
+    }
+
+    template<typename Map>
+    void
+    merge(const Map &map, uint32_t from, uint32_t to, int dir) {
+        if(map.isBlocked(from) || !neighborhood.canMove(map, from, to, dir)) {
+            return;
+        }
+        const uint32_t first  = find(from);
+        const uint32_t second = find(to);
+        if(first != second) {
+            parents[second] = first;
+        }
+    }
+
+public:
+    explicit ConnectedComponents(Neighborhood neighborhood = {}) : neighborhood(std::move(neighborhood)) {}
+
+    /// @brief Labels every region of a map, every cell pointing straight to the first cell of its region.
+    template<typename Map>
+    void
+    build(const Map &map) {
+        parents.assign(map.size(), 0);
+        stale = false;
+        for(uint32_t seed = 0; seed < map.size(); seed++) {
+            if(parents[seed] != 0 || map.isBlocked(seed)) {
+                continue;
+            }
+            parents[seed] = seed;
+            queue.assign(1, seed);
+            for(size_t idx = 0; idx < queue.size(); idx++) {
+                const uint32_t cell = queue[idx];
+                for(int dir = 0; dir < neighborhood.size(); dir++) {
+                    const uint32_t next = cell + neighborhood.offset(map, dir);
+                    if(parents[next] == 0 && neighborhood.canMove(map, cell, next, dir)) {
+                        parents[next] = seed;
+                        queue.push_back(next);
+                    }
+                }
+            }
+        }
+    }
+
+    /// @brief Updates the labels after a cell of the map was blocked or opened.
+    template<typename Map>
+    void
+    update(const Map &map, uint32_t cell) {
+        if(parents.empty()) {
+            return;
+        }
+        if(map.isBlocked(cell)) {
+            stale = true;
+            return;
+        }
+
+        // Opening a cell enables the moves into it, and may enable moves between its neighbors going around it
+        if(parents[cell] == 0) {
+            parents[cell] = cell;
+        }
+        for(int dir = 0; dir < neighborhood.size(); dir++) {
+            const uint32_t next = cell + neighborhood.offset(map, dir);
+            merge(map, cell, next, dir);
+            for(int around = 0; around < neighborhood.size(); around++) {
+                merge(map, next, next + neighborhood.offset(map, around), around);
+            }
+        }
+    }
+
+    /// @brief Checks if a path may join two free cells. Always true before the first build().
+    inline bool
+    connected(uint32_t from, uint32_t to) const {
+        if(parents.empty()) {
+            return true;
+        }
+        const uint32_t first = find(from);
+        return first != 0 && first == find(to);
+    }
+
+    /// @brief Same as connected() without compressing the paths of the forest, so any number of threads may call it at
+    /// once as long as the labels aren't updated meanwhile. Right after build() every cell points to its region, so it
+    /// costs no more.
+    inline bool
+    connectedShared(uint32_t from, uint32_t to) const {
+        if(parents.empty()) {
+            return true;
+        }
+        while(parents[from] != from) {
+            from = parents[from];
+        }
+        while(parents[to] != to) {
+            to = parents[to];
+        }
+        return from != 0 && from == to;
+    }
+
+    /// @brief True once a cell was blocked since the last build(), so cells may share a label without being connected.
+    inline bool
+    isStale() const {
+        return stale;
+    }
+
+    /// @brief Forgets the labels, every pair of cells is connected until the next build().
+    inline void
+    clear() {
+        parents.clear();
+        stale = false;
+    }
+};
+
+}    // namespace cam::pathfinder
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <math/Vector2.hpp>
+#include <pathfinder/Grid.hpp>
+#include <pathfinder/OpenSet.hpp>
+#include <pathfinder/Policies.hpp>
+#include <pathfinder/SearchCore.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace cam::pathfinder {
+
+/// @brief Distance to a goal and best move towards it for every cell of a map, for many agents sharing a destination.
+///
+/// A single Dijkstra search runs backwards from the goal over the whole map, so routing any number of agents costs one
+/// pass over the map plus a lookup per step of every path, instead of a search per agent. Moves must be reversible with
+/// the same cost, and their cost must not depend on the direction the cell was reached from.
+template<typename Map = Grid, typename Neighborhood = FourNeighborhood, typename Cost = UnitCost>
+class FlowField {
+public:
+    using Score = typename Cost::Score;
+    using Path  = std::vector<math::Vector2i>;
+
+    static constexpr Score INFINITE = SearchCore<Score>::INFINITE;
+    static constexpr int   NONE     = -1;
+
+private:
+    using Node = SearchNode<Score>;
+
+    Neighborhood        neighborhood;
+    Cost                costs;
+    std::vector<Score>  distances;
+    std::vector<int8_t> directions;    // move to do from every cell, NONE at the goal and where it can't be reached
+    std::vector<int>    offsets;
+    OpenSet<Node>       openSet;
+    uint32_t            goalCell = 0;
+    int                 width    = 0;
+    int                 height   = 0;
+    int                 stride   = 0;
+
+    inline bool
+    inside(int x, int y) const {
+        return x >= 0 && y >= 0 && x < width && y < height;
+    }
+
+    inline uint32_t
+    index(int x, int y) const {
+        return (uint32_t)((y + Grid::BORDER) * stride + x + Grid::BORDER);
+    }
+
+public:
+    explicit FlowField(Neighborhood neighborhood = {}, Cost costs = {}) : neighborhood(std::move(neighborhood)), costs(std::move(costs)) {}
+
+    /// @brief Computes the field towards a goal cell. A blocked goal leaves every cell unreachable.
+    void
+    build(const Map &map, uint32_t goal) {
+        goalCell = goal;
+        width    = map.getWidth();
+        height   = map.getHeight();
+        stride   = map.getStride();
+        distances.assign(map.size(), INFINITE);
+        directions.assign(map.size(), NONE);
+        offsets.resize(neighborhood.size());
+        for(int dir = 0; dir < neighborhood.size(); dir++) {
+            offsets[dir] = neighborhood.offset(map, dir);
+        }
+        if(goal == 0 || map.isBlocked(goal)) {
+            return;
+        }
+
+        openSet.reset(map.size());
+        distances[goal] = 0;
+        openSet.push(goal, {0, 0, goal, NONE, -1});
+        while(!openSet.empty()) {
+            const Node node = openSet.pop();
+            for(int dir = 0; dir < (int)offsets.size(); dir++) {
+                const uint32_t prev = node.cell - offsets[dir];
+                if(map.isBlocked(prev) || !neighborhood.canMove(map, prev, node.cell, dir)) {
+                    continue;
+                }
+                const Score g = costs.step(map, {node.g, node.g, prev, dir, -1}, node.cell, dir);
+                if(g < distances[prev]) {
+                    distances[prev]  = g;
+                    directions[prev] = (int8_t)dir;
+                    openSet.push(prev, {g, g, prev, dir, -1});
+                }
+            }
+        }
+    }
+
+    /// @brief Computes the field towards the END cell of a map.
+    void
+    build(const Map &map) {
+        build(map, map.find(END));
+    }
+
+    /// @brief Cost to the goal from a position, INFINITE if it can't be reached.
+    inline Score
+    distance(int x, int y) const {
+        return inside(x, y) ? distances[index(x, y)] : INFINITE;
+    }
+
+    /// @brief Move to do from a position to get closer to the goal, NONE at the goal or where it can't be reached.
+    inline int
+    direction(int x, int y) const {
+        return inside(x, y) ? directions[index(x, y)] : NONE;
+    }
+
+    /// @brief Follows the field from a position to the goal.
+    /// @return An optimal path, empty if the goal can't be reached.
+    Path
+    path(int x, int y) const {
+        Path path;
+        if(distance(x, y) == INFINITE) {
+            return path;
+        }
+        for(uint32_t cell = index(x, y);; cell += offsets[directions[cell]]) {
+            path.emplace_back((int)(cell % stride) - Grid::BORDER, (int)(cell / stride) - Grid::BORDER);
+            if(cell == goalCell) {
+                return path;
+            }
+        }
+    }
+};
+
+}    // namespace cam::pathfinder
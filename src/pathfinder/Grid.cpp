@@ -0,0 +1,26 @@
+#include "Grid.hpp"
+
+#include <algorithm>
+
+namespace cam::pathfinder {
+
+Grid::Grid(int width, int height, Type fill) : width(width), height(height), stride(width + 2 * BORDER) {
+    cells.assign((size_t)stride * (height + 2 * BORDER), BLOCK);
+    for(int y = 0; y < height; y++) {
+        std::fill_n(cells.begin() + index(0, y), width, fill);
+    }
+}
+
+uint32_t
+Grid::find(Type type) const {
+    for(int y = 0; y < height; y++) {
+        for(uint32_t cell = index(0, y), last = cell + width; cell < last; cell++) {
+            if((cells[cell] & TYPE_MASK) == type) {
+                return cell;
+            }
+        }
+    }
+    return 0;
+}
+
+}    // namespace cam::pathfinder
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <math/Vector2.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace cam::pathfinder {
+
+enum Type : uint8_t { EMPTY, START, END, BLOCK };
+
+/// @brief Contiguous row-major map storage, one byte per cell.
+///
+/// The two lowest bits of every byte hold the Type of the cell and the rest its terrain weight, the cost of entering
+/// it, so the search reads both with a single load. Unweighted cells have weight one and store just their Type.
+///
+/// The map is surrounded by a one cell wide frame of BLOCK cells, so a cell id plus any neighbor offset always lands
+/// inside the buffer and searches don't need bounds checks. Cells are addressed either by integer coordinates or by
+/// their cell id, the index inside the padded buffer.
+class Grid {
+    // Decodes whole rows of text straight into the cells
+    friend class MapLoader;
+
+    static constexpr uint8_t TYPE_MASK    = 0x03;
+    static constexpr int     WEIGHT_SHIFT = 2;
+
+    std::vector<uint8_t> cells;
+    int                  width    = 0;
+    int                  height   = 0;
+    int                  stride   = 0;
+    bool                 weighted = false;
+
+public:
+    static constexpr int BORDER     = 1;
+    static constexpr int MAX_WEIGHT = (0xFF >> WEIGHT_SHIFT) + 1;
+
+    Grid() = default;
+    Grid(int width, int height, Type fill = EMPTY);
+
+    inline int
+    getWidth() const {
+        return width;
+    }
+    inline int
+    getHeight() const {
+        return height;
+    }
+    inline int
+    getStride() const {
+        return stride;
+    }
+    /// @brief Number of cells of the padded buffer, the upper bound of any cell id.
+    inline size_t
+    size() const {
+        return cells.size();
+    }
+    inline bool
+    empty() const {
+        return width == 0 || height == 0;
+    }
+
+    inline bool
+    inside(int x, int y) const {
+        return x >= 0 && y >= 0 && x < width && y < height;
+    }
+    inline uint32_t
+    index(int x, int y) const {
+        return (y + BORDER) * stride + (x + BORDER);
+    }
+    inline math::Vector2i
+    position(uint32_t cell) const {
+        return {(int)(cell % stride) - BORDER, (int)(cell / stride) - BORDER};
+    }
+    /// @brief Offset to add to a cell id to move by the given amount of columns and rows.
+    inline int
+    offset(int dx, int dy) const {
+        return dy * stride + dx;
+    }
+
+    inline Type
+    at(uint32_t cell) const {
+        return static_cast<Type>(cells[cell] & TYPE_MASK);
+    }
+    inline Type
+    at(int x, int y) const {
+        return at(index(x, y));
+    }
+    inline bool
+    isBlocked(uint32_t cell) const {
+        return (cells[cell] & TYPE_MASK) == BLOCK;
+    }
+    /// @brief Changes the Type of a cell, keeping its weight.
+    inline void
+    set(uint32_t cell, Type type) {
+        cells[cell] = (cells[cell] & ~TYPE_MASK) | type;
+    }
+    inline void
+    set(int x, int y, Type type) {
+        set(index(x, y), type);
+    }
+
+    /// @brief Cost of entering a cell, from 1 to MAX_WEIGHT.
+    inline int
+    weight(uint32_t cell) const {
+        return (cells[cell] >> WEIGHT_SHIFT) + 1;
+    }
+    inline int
+    weight(int x, int y) const {
+        return weight(index(x, y));
+    }
+    /// @brief Changes the cost of entering a cell, clamped to 1 to MAX_WEIGHT.
+    inline void
+    setWeight(uint32_t cell, int weight) {
+        weight      = weight < 1 ? 1 : weight > MAX_WEIGHT ? MAX_WEIGHT : weight;
+        cells[cell] = (uint8_t)(((weight - 1) << WEIGHT_SHIFT) | (cells[cell] & TYPE_MASK));
+        weighted |= weight > 1;
+    }
+    inline void
+    setWeight(int x, int y, int weight) {
+        setWeight(index(x, y), weight);
+    }
+    /// @brief Checks if some cell was ever given a weight other than one.
+    inline bool
+    isWeighted() const {
+        return weighted;
+    }
+
+    /// @brief Finds the first cell of the given type, scanning row by row.
+    /// @return The cell id, or 0 (always a border cell) if there is none.
+    uint32_t find(Type type) const;
+};
+
+}    // namespace cam::pathfinder
@@ -0,0 +1,378 @@
+#include "HierarchicalPathFinder.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace cam::pathfinder {
+
+namespace {
+
+// Runs of free cells at least this long get an entrance at each end instead of a single one in the middle
+constexpr int LONG_ENTRANCE = 6;
+
+}    // namespace
+
+HierarchicalPathFinder::HierarchicalPathFinder(int clusterSize) : clusterSize(std::max(clusterSize, 2)) {
+}
+
+size_t
+HierarchicalPathFinder::clusterOf(uint32_t cell) const {
+    const int x = (int)(cell % map.getStride()) - Grid::BORDER;
+    const int y = (int)(cell / map.getStride()) - Grid::BORDER;
+    return (size_t)(y / clusterSize) * columns + x / clusterSize;
+}
+
+void
+HierarchicalPathFinder::addEntrances(Cluster &cluster, uint32_t first, int along, int across, int length) {
+    auto add = [&](uint32_t cell) {
+        if(entrances[cell] < 0) {
+            entrances[cell] = (int16_t)cluster.nodes.size();
+            cluster.nodes.push_back(cell);
+        }
+    };
+
+    int run = 0;
+    for(int idx = 0; idx <= length; idx++) {
+        const uint32_t cell = first + idx * along;
+        if(idx < length && !map.isBlocked(cell) && !map.isBlocked(cell + across)) {
+            run++;
+            continue;
+        }
+        if(run >= LONG_ENTRANCE) {
+            add(cell - run * along);
+            add(cell - along);
+        } else if(run > 0) {
+            add(cell - (run + 1) / 2 * along);
+        }
+        run = 0;
+    }
+}
+
+void
+HierarchicalPathFinder::rebuild(Cluster &cluster) {
+    for(uint32_t cell : cluster.nodes) {
+        entrances[cell] = -1;
+    }
+    cluster.nodes.clear();
+
+    const int      stride  = map.getStride();
+    const uint32_t topLeft = map.index(cluster.x, cluster.y);
+    if(cluster.y > 0) {
+        addEntrances(cluster, topLeft, 1, -stride, cluster.width);
+    }
+    if(cluster.x + cluster.width < map.getWidth()) {
+        addEntrances(cluster, topLeft + cluster.width - 1, stride, 1, cluster.height);
+    }
+    if(cluster.y + cluster.height < map.getHeight()) {
+        addEntrances(cluster, topLeft + (cluster.height - 1) * stride, 1, stride, cluster.width);
+    }
+    if(cluster.x > 0) {
+        addEntrances(cluster, topLeft, stride, -1, cluster.height);
+    }
+
+    const size_t count = cluster.nodes.size();
+    cluster.distances.assign(count * count, INFINITE);
+    for(size_t from = 0; from < count; from++) {
+        explore(cluster, cluster.nodes[from]);
+        for(size_t to = 0; to < count; to++) {
+            cluster.distances[from * count + to] = distanceTo(cluster, cluster.nodes[to]);
+        }
+    }
+    cluster.dirty = false;
+    rebuilt++;
+}
+
+void
+HierarchicalPathFinder::refresh() {
+    rebuilt = 0;
+    for(auto &cluster : clusters) {
+        if(cluster.dirty) {
+            rebuild(cluster);
+        }
+    }
+}
+
+void
+HierarchicalPathFinder::invalidate(int x, int y) {
+    if(map.inside(x, y)) {
+        clusters[(size_t)(y / clusterSize) * columns + x / clusterSize].dirty = true;
+    }
+}
+
+void
+HierarchicalPathFinder::explore(const Cluster &cluster, uint32_t source) {
+    distance.assign((size_t)cluster.width * cluster.height, INFINITE);
+    queue.clear();
+
+    const int stride = map.getStride();
+    const int first  = (int)map.index(cluster.x, cluster.y);
+    auto      local  = [&](uint32_t cell) { return (size_t)(((int)cell - first) / stride * cluster.width + ((int)cell - first) % stride); };
+    auto      inside = [&](uint32_t cell) {
+        const int dx = ((int)cell - first) % stride;
+        const int dy = ((int)cell - first) / stride;
+        return (int)cell >= first && dx < cluster.width && dy < cluster.height;
+    };
+
+    if(map.isBlocked(source)) {
+        return;
+    }
+    distance[local(source)] = 0;
+    const int offsets[] = {-stride, 1, stride, -1};
+    if(map.isWeighted()) {
+        // Dijkstra, keyed by the position in the cluster so every cell is queued once
+        frontier.reset(previous.size());
+        frontier.push((uint32_t)local(source), {0, 0, source, 0, 0});
+        while(!frontier.empty()) {
+            const SearchNode<int> node = frontier.pop();
+            for(int offset : offsets) {
+                const uint32_t next = node.cell + offset;
+                if(map.isBlocked(next) || !inside(next)) {
+                    continue;
+                }
+                const int score = node.g + map.weight(next);
+                if(score < distance[local(next)]) {
+                    distance[local(next)] = score;
+                    previous[local(next)] = node.cell;
+                    frontier.push((uint32_t)local(next), {score, score, next, 0, 0});
+                }
+            }
+        }
+        return;
+    }
+
+    queue.push_back(source);
+    for(size_t head = 0; head < queue.size(); head++) {
+        const uint32_t cell  = queue[head];
+        const int      score = distance[local(cell)] + 1;
+        for(int offset : offsets) {
+            const uint32_t next = cell + offset;
+            if(map.isBlocked(next) || !inside(next) || distance[local(next)] != INFINITE) {
+                continue;
+            }
+            distance[local(next)] = score;
+            previous[local(next)] = cell;
+            queue.push_back(next);
+        }
+    }
+}
+
+int
+HierarchicalPathFinder::distanceTo(const Cluster &cluster, uint32_t cell) const {
+    const int first = (int)map.index(cluster.x, cluster.y);
+    const int delta = (int)cell - first;
+    return distance[(size_t)(delta / map.getStride() * cluster.width + delta % map.getStride())];
+}
+
+int
+HierarchicalPathFinder::searchAbstract(uint32_t start, uint32_t goal) {
+    abstractPath.clear();
+    const Cluster &startCluster = clusters[clusterOf(start)];
+    const Cluster &goalCluster  = clusters[clusterOf(goal)];
+
+    explore(startCluster, start);
+    startDistances.clear();
+    for(uint32_t cell : startCluster.nodes) {
+        startDistances.push_back(distanceTo(startCluster, cell));
+    }
+    const int direct = &startCluster == &goalCluster ? distanceTo(startCluster, goal) : INFINITE;
+
+    explore(goalCluster, goal);
+    goalDistances.clear();
+    for(uint32_t cell : goalCluster.nodes) {
+        goalDistances.push_back(distanceTo(goalCluster, cell));
+    }
+
+    openSet.reset(map.size());
+    closed.reset(map.size());
+    const int stride = map.getStride();
+    const int goalX  = (int)(goal % stride);
+    const int goalY  = (int)(goal / stride);
+    auto      relax  = [&](uint32_t from, uint32_t to, int g) {
+        if(!closed.contains(to)) {
+            const int h = std::abs(goalX - (int)(to % stride)) + std::abs(goalY - (int)(to / stride));
+            if(openSet.push(to, {g + h, g, to, 0, 0})) {
+                parents[to] = from;
+            }
+        }
+    };
+
+    parents[start] = 0;
+    openSet.push(start, {0, 0, start, 0, 0});
+    while(!openSet.empty()) {
+        const SearchNode<int> node = openSet.pop();
+        const uint32_t        cell = node.cell;
+        closed.close(cell, node.g);
+        if(cell == goal) {
+            for(uint32_t step = goal; step != 0; step = parents[step]) {
+                abstractPath.push_back(step);
+            }
+            std::reverse(abstractPath.begin(), abstractPath.end());
+            return node.g;
+        }
+
+        if(cell == start) {
+            for(size_t idx = 0; idx < startCluster.nodes.size(); idx++) {
+                if(startDistances[idx] != INFINITE) {
+                    relax(cell, startCluster.nodes[idx], startDistances[idx]);
+                }
+            }
+            if(direct != INFINITE) {
+                relax(cell, goal, direct);
+            }
+        }
+
+        const int entrance = entrances[cell];
+        if(entrance < 0) {
+            continue;
+        }
+        const Cluster &cluster = clusters[clusterOf(cell)];
+        const size_t   count   = cluster.nodes.size();
+        for(size_t idx = 0; idx < count; idx++) {
+            const int distance = cluster.distances[entrance * count + idx];
+            if(distance != INFINITE) {
+                relax(cell, cluster.nodes[idx], node.g + distance);
+            }
+        }
+        for(int offset : {-stride, 1, stride, -1}) {
+            const uint32_t next = cell + offset;
+            if(entrances[next] >= 0 && &clusters[clusterOf(next)] != &cluster) {
+                relax(cell, next, node.g + map.weight(next));
+            }
+        }
+        if(&cluster == &goalCluster && goalDistances[entrance] != INFINITE) {
+            relax(cell, goal, node.g + goalDistances[entrance]);
+        }
+    }
+    return INFINITE;
+}
+
+void
+HierarchicalPathFinder::refine(Path &path) {
+    path.clear();
+    if(abstractPath.empty()) {
+        return;
+    }
+
+    path.push_back(map.position(abstractPath.front()));
+    for(size_t idx = 1; idx < abstractPath.size(); idx++) {
+        const uint32_t from = abstractPath[idx - 1];
+        const uint32_t to   = abstractPath[idx];
+        if(clusterOf(from) != clusterOf(to)) {
+            path.push_back(map.position(to));
+            continue;
+        }
+
+        const Cluster &cluster = clusters[clusterOf(from)];
+        explore(cluster, from);
+        const int      first = (int)map.index(cluster.x, cluster.y);
+        const size_t   mark  = path.size();
+        for(uint32_t cell = to; cell != from;) {
+            path.push_back(map.position(cell));
+            const int delta = (int)cell - first;
+            cell            = previous[(size_t)(delta / map.getStride() * cluster.width + delta % map.getStride())];
+        }
+        std::reverse(path.begin() + mark, path.end());
+    }
+}
+
+void
+HierarchicalPathFinder::set(Grid map) {
+    this->map = std::move(map);
+    startCell = this->map.find(START);
+    endCell   = this->map.find(END);
+    minCost   = INFINITE;
+    solution.clear();
+
+    columns = (this->map.getWidth() + clusterSize - 1) / clusterSize;
+    rows    = (this->map.getHeight() + clusterSize - 1) / clusterSize;
+    clusters.assign((size_t)columns * rows, Cluster());
+    for(int row = 0; row < rows; row++) {
+        for(int column = 0; column < columns; column++) {
+            Cluster &cluster = clusters[(size_t)row * columns + column];
+            cluster.x        = column * clusterSize;
+            cluster.y        = row * clusterSize;
+            cluster.width    = std::min(clusterSize, this->map.getWidth() - cluster.x);
+            cluster.height   = std::min(clusterSize, this->map.getHeight() - cluster.y);
+        }
+    }
+    entrances.assign(this->map.size(), -1);
+    parents.resize(this->map.size());
+    previous.resize((size_t)clusterSize * clusterSize);
+    refresh();
+}
+
+void
+HierarchicalPathFinder::updateCell(int x, int y, Type type) {
+    if(!map.inside(x, y)) {
+        return;
+    }
+
+    const uint32_t cell = map.index(x, y);
+    if(type == START && startCell != 0) {
+        map.set(startCell, EMPTY);
+    } else if(type == END && endCell != 0) {
+        map.set(endCell, EMPTY);
+    }
+    startCell = type == START ? cell : startCell == cell ? 0 : startCell;
+    endCell   = type == END ? cell : endCell == cell ? 0 : endCell;
+
+    const bool wasBlocked = map.isBlocked(cell);
+    map.set(cell, type);
+    if(wasBlocked == map.isBlocked(cell)) {
+        return;
+    }
+
+    // Entrances depend on the cells at both sides of a border
+    invalidate(x, y);
+    if(x % clusterSize == 0) {
+        invalidate(x - 1, y);
+    }
+    if(x % clusterSize == clusterSize - 1) {
+        invalidate(x + 1, y);
+    }
+    if(y % clusterSize == 0) {
+        invalidate(x, y - 1);
+    }
+    if(y % clusterSize == clusterSize - 1) {
+        invalidate(x, y + 1);
+    }
+}
+
+HierarchicalPathFinder::Path
+HierarchicalPathFinder::solve() {
+    QueryResult result;
+    if(startCell != 0 && endCell != 0) {
+        solve({map.position(startCell), map.position(endCell)}, result);
+    } else {
+        result.cost = std::numeric_limits<double>::max();
+    }
+    minCost  = result.path.empty() ? INFINITE : (int)result.cost;
+    solution = std::move(result.path);
+    return solution;
+}
+
+void
+HierarchicalPathFinder::solve(const Query &query, QueryResult &result) {
+    refresh();
+    result.path.clear();
+    result.cost  = std::numeric_limits<double>::max();
+    result.bound = std::numeric_limits<double>::infinity();
+
+    const auto &[from, to] = query;
+    if(!map.inside(from.getX(), from.getY()) || !map.inside(to.getX(), to.getY())) {
+        return;
+    }
+    const uint32_t start = map.index(from.getX(), from.getY());
+    const uint32_t goal  = map.index(to.getX(), to.getY());
+    if(map.isBlocked(start) || map.isBlocked(goal)) {
+        return;
+    }
+
+    const int cost = searchAbstract(start, goal);
+    if(cost != INFINITE) {
+        refine(result.path);
+        result.cost = cost;
+    }
+}
+
+}    // namespace cam::pathfinder
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <math/Vector2.hpp>
+#include <pathfinder/ClosedSet.hpp>
+#include <pathfinder/Grid.hpp>
+#include <pathfinder/IndexedHeap.hpp>
+#include <pathfinder/QuerySolver.hpp>
+#include <pathfinder/SearchCore.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace cam::pathfinder {
+
+/// @brief Path finder for very large maps, searching an abstraction of the map made of square clusters (HPA*).
+///
+/// The map is split into clusters, and every run of free cells along the border between two clusters becomes one or two
+/// entrances. The distances between the entrances of a cluster are computed once, so a query only searches the small
+/// graph of entrances and then refines each step of it with a search inside a single cluster. Query work depends on the
+/// number of clusters crossed and the cluster size, not on the size of the map.
+///
+/// Editing a cell only invalidates its cluster, plus the neighbor sharing the border if the cell lies on it, and those
+/// are rebuilt lazily by the next query. Moves are the four straight ones, and entering a cell costs its terrain weight
+/// as in PathFinder. Paths are optimal inside every cluster but the whole path may be slightly costlier than the
+/// optimal one, as it must cross clusters at the entrances.
+class HierarchicalPathFinder {
+public:
+    using Path = std::vector<math::Vector2i>;
+
+    static constexpr int INFINITE = std::numeric_limits<int>::max();
+
+private:
+    struct Cluster {
+        int                   x      = 0;    // first column
+        int                   y      = 0;    // first row
+        int                   width  = 0;
+        int                   height = 0;
+        std::vector<uint32_t> nodes;        // cell ids of the entrances
+        std::vector<int>      distances;    // distance between every pair of entrances, INFINITE if not connected
+        bool                  dirty = true;
+    };
+
+    Grid                 map;
+    int                  clusterSize = 16;
+    int                  columns     = 0;
+    int                  rows        = 0;
+    uint32_t             startCell   = 0;
+    uint32_t             endCell     = 0;
+    int                  minCost     = INFINITE;
+    Path                 solution;
+    std::vector<Cluster> clusters;
+    std::vector<int16_t> entrances;    // index of every cell in the entrances of its cluster, -1 if it is not one
+    size_t               rebuilt = 0;
+
+    // Search inside a cluster, indexed by the position relative to the cluster
+    std::vector<int>             distance;
+    std::vector<uint32_t>        previous;
+    std::vector<uint32_t>        queue;       // breadth first search of unweighted maps
+    IndexedHeap<SearchNode<int>> frontier;    // Dijkstra of weighted ones
+
+    // Search of the abstract graph, indexed by cell id
+    IndexedHeap<SearchNode<int>> openSet;
+    ClosedSet<int>               closed;
+    std::vector<uint32_t>        parents;
+    std::vector<int>             startDistances;
+    std::vector<int>             goalDistances;
+    std::vector<uint32_t>        abstractPath;
+
+    size_t clusterOf(uint32_t cell) const;
+    void   addEntrances(Cluster &cluster, uint32_t first, int along, int across, int length);
+    void   rebuild(Cluster &cluster);
+    void   refresh();
+    void   invalidate(int x, int y);
+
+    /// @brief Cheapest paths from a cell to the others of its cluster, without leaving it.
+    void explore(const Cluster &cluster, uint32_t source);
+    int  distanceTo(const Cluster &cluster, uint32_t cell) const;
+
+    /// @brief Searches the abstract graph, leaving the list of cells to go through in abstractPath.
+    int  searchAbstract(uint32_t start, uint32_t goal);
+    void refine(Path &path);
+
+public:
+    /// @param clusterSize Width and height of the clusters, in cells. Bigger clusters make a smaller abstract graph but
+    /// costlier local searches.
+    explicit HierarchicalPathFinder(int clusterSize = 16);
+
+    /// @brief Replaces the map, looking for its START and END cells, and builds the abstraction of every cluster.
+    void set(Grid map);
+
+    inline const Grid &
+    getMap() const {
+        return map;
+    }
+
+    /// @brief Changes a cell of the map, invalidating only the clusters whose abstraction depends on it.
+    void updateCell(int x, int y, Type type);
+
+    /// @brief Searches a path from START to END.
+    Path solve();
+
+    /// @brief Solves a path between two positions of the current map.
+    void solve(const Query &query, QueryResult &result);
+
+    /// @brief Cost of the last path solved from START to END, INFINITE if there was none.
+    inline int
+    cost() const {
+        return minCost;
+    }
+
+    inline size_t
+    clusterCount() const {
+        return clusters.size();
+    }
+
+    /// @brief Number of clusters rebuilt by the last set() or query, the ones invalidated by the edits in between.
+    inline size_t
+    rebuiltClusters() const {
+        return rebuilt;
+    }
+};
+
+}    // namespace cam::pathfinder
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <math/Vector2.hpp>
+#include <pathfinder/Grid.hpp>
+#include <pathfinder/IndexedHeap.hpp>
+#include <pathfinder/Policies.hpp>
+#include <pathfinder/SearchCore.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace cam::pathfinder {
+
+/// @brief Path finder that repairs its solution when cells of the map change, instead of searching from scratch.
+///
+/// Implements D* Lite: the search runs backwards from END, keeping for every cell its distance to END (g) and a one
+/// step lookahead of it (rhs). A changed cell only makes its neighbors inconsistent, and solve() propagates the change
+/// until the start is consistent again, so the work done scales with the part of the map whose distances actually
+/// changed. The start may also move along the path without discarding what was already searched.
+///
+/// Uses the same compile-time policies as BasicPathFinder. Moves must be reversible with the same cost, and their cost
+/// must not depend on the direction the cell was reached from.
+template<typename Map = Grid, typename Neighborhood = FourNeighborhood, typename Cost = UnitCost, typename Heuristic = ManhattanHeuristic>
+class IncrementalPathFinder {
+public:
+    using Score = typename Cost::Score;
+    using Path  = std::vector<math::Vector2i>;
+
+    static constexpr Score INFINITE = std::numeric_limits<Score>::max();
+
+private:
+    struct Key {
+        Score    first;
+        Score    second;
+        uint32_t cell;
+
+        bool
+        operator>(const Key &other) const {
+            return first > other.first || (first == other.first && second > other.second);
+        }
+    };
+
+    Map                map;
+    Neighborhood       neighborhood;
+    Cost               costs;
+    Heuristic          heuristic;
+    uint32_t           startCell = 0;
+    uint32_t           endCell   = 0;
+    uint32_t           lastStart = 0;
+    Score              km        = 0;
+    std::vector<Score> g;
+    std::vector<Score> rhs;
+    IndexedHeap<Key>   openSet;
+    size_t             expanded = 0;
+
+    inline Score
+    estimate(uint32_t cell) const {
+        return pathfinder::estimate(heuristic, map, cell, startCell);
+    }
+
+    inline Key
+    key(uint32_t cell) const {
+        const Score best = std::min(g[cell], rhs[cell]);
+        if(best == INFINITE) {
+            return {INFINITE, INFINITE, cell};
+        }
+        return {best + estimate(cell) + km, best, cell};
+    }
+
+    /// @brief Checks the move between two cells, blocked cells can't be left nor entered.
+    inline bool
+    walkable(uint32_t from, uint32_t to, int dir) const {
+        return !map.isBlocked(from) && neighborhood.canMove(map, from, to, dir);
+    }
+
+    /// @brief Cost of a move, only valid if it is walkable.
+    inline Score
+    step(uint32_t from, uint32_t to, int dir) const {
+        return costs.step(map, {0, 0, from, dir, -1}, to, dir);
+    }
+
+    /// @brief Recomputes the lookahead of a cell and queues it while it is inconsistent.
+    void
+    update(uint32_t cell) {
+        if(cell != endCell) {
+            rhs[cell] = INFINITE;
+            if(!map.isBlocked(cell)) {
+                for(int dir = 0; dir < neighborhood.size(); dir++) {
+                    const uint32_t next = cell + neighborhood.offset(map, dir);
+                    if(g[next] != INFINITE && walkable(cell, next, dir)) {
+                        rhs[cell] = std::min(rhs[cell], step(cell, next, dir) + g[next]);
+                    }
+                }
+            }
+        }
+        openSet.remove(cell);
+        if(g[cell] != rhs[cell]) {
+            openSet.push(cell, key(cell));
+        }
+    }
+
+    /// @brief Updates every cell that could move into the given one, whether the move is still allowed or not.
+    void
+    updatePredecessors(uint32_t cell) {
+        for(int dir = 0; dir < neighborhood.size(); dir++) {
+            update(cell - neighborhood.offset(map, dir));
+        }
+    }
+
+    void
+    computeShortestPath() {
+        while(!openSet.empty() && (key(startCell) > openSet.top() || rhs[startCell] != g[startCell])) {
+            const Key      old  = openSet.top();
+            const uint32_t cell = old.cell;
+            const Key      now  = key(cell);
+            expanded++;
+            if(now > old) {
+                openSet.remove(cell);
+                openSet.push(cell, now);
+            } else if(g[cell] > rhs[cell]) {
+                g[cell] = rhs[cell];
+                openSet.remove(cell);
+                updatePredecessors(cell);
+            } else {
+                g[cell] = INFINITE;
+                update(cell);
+                updatePredecessors(cell);
+            }
+        }
+    }
+
+    void
+    initialize() {
+        g.assign(map.size(), INFINITE);
+        rhs.assign(map.size(), INFINITE);
+        openSet.reset(map.size());
+        km        = 0;
+        lastStart = startCell;
+        if(startCell != 0 && endCell != 0) {
+            rhs[endCell] = 0;
+            openSet.push(endCell, key(endCell));
+        }
+    }
+
+public:
+    explicit IncrementalPathFinder(Neighborhood neighborhood = {}, Cost costs = {}, Heuristic heuristic = {})
+        : neighborhood(std::move(neighborhood)), costs(std::move(costs)), heuristic(std::move(heuristic)) {
+    }
+
+    /// @brief Replaces the map, looking for its START and END cells, and discards everything searched.
+    void
+    set(Map map) {
+        this->map = std::move(map);
+        startCell = this->map.find(START);
+        endCell   = this->map.find(END);
+        initialize();
+    }
+
+    inline const Map &
+    getMap() const {
+        return map;
+    }
+
+    /// @brief Changes a cell of the map. Only its neighborhood is updated, the path is repaired by the next solve().
+    /// Setting a START cell moves the start there, and setting an END cell starts a new search towards it.
+    void
+    updateCell(int x, int y, Type type) {
+        if(!map.inside(x, y)) {
+            return;
+        }
+
+        const uint32_t cell       = map.index(x, y);
+        const bool     wasBlocked = map.isBlocked(cell);
+        if(type == START) {
+            if(startCell != 0) {
+                map.set(startCell, EMPTY);
+            }
+            map.set(cell, START);
+            moveStart(x, y);
+            if(wasBlocked && endCell != 0) {
+                update(cell);
+                updatePredecessors(cell);
+            }
+            return;
+        }
+        if(type == END) {
+            if(endCell != 0) {
+                map.set(endCell, EMPTY);
+            }
+            map.set(cell, END);
+            endCell = cell;
+            initialize();
+            return;
+        }
+
+        map.set(cell, type);
+        if(cell == startCell) {
+            startCell = 0;
+        } else if(cell == endCell) {
+            endCell = 0;
+        }
+        if(wasBlocked != map.isBlocked(cell) && startCell != 0 && endCell != 0) {
+            update(cell);
+            updatePredecessors(cell);
+        }
+    }
+
+    /// @brief Moves the start, keeping the distances already known, as the goal of the search doesn't change.
+    void
+    moveStart(int x, int y) {
+        if(!map.inside(x, y)) {
+            return;
+        }
+        const uint32_t cell = map.index(x, y);
+        if(startCell == 0 || endCell == 0) {
+            startCell = cell;
+            initialize();
+            return;
+        }
+        startCell = cell;
+        km += pathfinder::estimate(heuristic, map, lastStart, startCell);
+        lastStart = startCell;
+    }
+
+    /// @brief Repairs the distances after the last changes and follows them from the start to END.
+    /// @return An optimal path, empty if there is none.
+    Path
+    solve() {
+        expanded = 0;
+        Path path;
+        if(startCell == 0 || endCell == 0 || map.isBlocked(startCell)) {
+            return path;
+        }
+
+        computeShortestPath();
+        if(g[startCell] == INFINITE) {
+            return path;
+        }
+
+        path.push_back(map.position(startCell));
+        for(uint32_t cell = startCell; cell != endCell && path.size() <= map.size();) {
+            uint32_t best      = 0;
+            Score    bestScore = INFINITE;
+            for(int dir = 0; dir < neighborhood.size(); dir++) {
+                const uint32_t next = cell + neighborhood.offset(map, dir);
+                if(g[next] != INFINITE && walkable(cell, next, dir) && step(cell, next, dir) + g[next] < bestScore) {
+                    best      = next;
+                    bestScore = step(cell, next, dir) + g[next];
+                }
+            }
+            if(best == 0) {
+                return {};
+            }
+            cell = best;
+            path.push_back(map.position(cell));
+        }
+        return path.back() == map.position(endCell) ? path : Path();
+    }
+
+    /// @brief Cost of the path from the start, INFINITE if there is none. Only valid after solve().
+    inline Score
+    cost() const {
+        return startCell == 0 || endCell == 0 ? INFINITE : g[startCell];
+    }
+
+    /// @brief Number of cells processed by the last solve(), which measures the size of the repair.
+    inline size_t
+    expansions() const {
+        return expanded;
+    }
+};
+
+}    // namespace cam::pathfinder
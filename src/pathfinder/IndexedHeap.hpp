@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace cam::pathfinder {
+
+/// @brief Priority queue of items keyed by an integer id, with the lowest item on top and O(log n) decrease-key.
+///
+/// Every key is in the queue at most once: pushing a key that is already queued keeps the lowest of both items, so the
+/// queue never holds stale duplicates that have to be skipped later. Positions are stamped with a generation, as in
+/// ClosedSet, so clearing the queue doesn't touch the key arrays.
+/// @tparam Item Queued value, ordered with operator>.
+/// @tparam D Number of children of every heap node. Wider heaps are shallower, which favours the frequent decrease-key
+/// and push over the pop.
+template<typename Item, int D = 4>
+class IndexedHeap {
+    static_assert(D >= 2, "A heap needs at least two children per node");
+
+    struct Entry {
+        Item     item;
+        uint32_t key;
+    };
+
+    std::vector<Entry>    heap;
+    std::vector<uint32_t> positions;
+    std::vector<uint32_t> stamps;
+    uint32_t              generation = 0;
+
+    inline void
+    place(size_t index, Entry &&entry) {
+        positions[entry.key] = index;
+        heap[index]          = std::move(entry);
+    }
+
+    void
+    siftUp(size_t index) {
+        Entry entry = std::move(heap[index]);
+        while(index > 0) {
+            const size_t parent = (index - 1) / D;
+            if(!(heap[parent].item > entry.item)) {
+                break;
+            }
+            place(index, std::move(heap[parent]));
+            index = parent;
+        }
+        place(index, std::move(entry));
+    }
+
+    void
+    siftDown(size_t index) {
+        Entry        entry = std::move(heap[index]);
+        const size_t count = heap.size();
+        while(true) {
+            const size_t first = index * D + 1;
+            if(first >= count) {
+                break;
+            }
+            size_t best = first;
+            for(size_t child = first + 1; child < std::min(first + D, count); child++) {
+                if(heap[best].item > heap[child].item) {
+                    best = child;
+                }
+            }
+            if(!(entry.item > heap[best].item)) {
+                break;
+            }
+            place(index, std::move(heap[best]));
+            index = best;
+        }
+        place(index, std::move(entry));
+    }
+
+public:
+    /// @brief Empties the queue and makes room for the given number of keys.
+    void
+    reset(size_t keys) {
+        heap.clear();
+        if(stamps.size() != keys) {
+            stamps.assign(keys, 0);
+            positions.resize(keys);
+            generation = 0;
+        }
+        if(++generation == 0) {
+            std::fill(stamps.begin(), stamps.end(), 0);
+            generation = 1;
+        }
+    }
+
+    /// @brief Makes room for the given number of items, so pushing them never grows the heap past it.
+    inline void
+    reserve(size_t items) {
+        heap.reserve(items);
+    }
+
+    inline bool
+    empty() const {
+        return heap.empty();
+    }
+
+    inline size_t
+    size() const {
+        return heap.size();
+    }
+
+    /// @brief Memory held by the heap, in bytes.
+    inline size_t
+    bytes() const {
+        return heap.capacity() * sizeof(Entry) + (positions.capacity() + stamps.capacity()) * sizeof(uint32_t);
+    }
+
+    /// @brief Checks if the key is waiting in the queue.
+    inline bool
+    contains(uint32_t key) const {
+        return stamps[key] == generation && positions[key] < heap.size() && heap[positions[key]].key == key;
+    }
+
+    /// @brief Item queued for a key, only valid if the key is contained.
+    inline const Item &
+    get(uint32_t key) const {
+        return heap[positions[key]].item;
+    }
+
+    /// @brief Queues an item, or lowers the one already queued for the same key.
+    /// @return True if the queue changed, false if the key was already queued with an item not greater than this one.
+    bool
+    push(uint32_t key, const Item &item) {
+        if(contains(key)) {
+            const size_t index = positions[key];
+            if(!(heap[index].item > item)) {
+                return false;
+            }
+            heap[index].item = item;
+            siftUp(index);
+            return true;
+        }
+        stamps[key] = generation;
+        heap.push_back({item, key});
+        siftUp(heap.size() - 1);
+        return true;
+    }
+
+    /// @brief Removes the item queued for a key, if any.
+    void
+    remove(uint32_t key) {
+        if(!contains(key)) {
+            return;
+        }
+        const size_t index = positions[key];
+        if(index + 1 == heap.size()) {
+            heap.pop_back();
+            return;
+        }
+        const uint32_t moved = heap.back().key;
+        place(index, std::move(heap.back()));
+        heap.pop_back();
+        siftUp(index);
+        siftDown(positions[moved]);
+    }
+
+    inline const Item &
+    top() const {
+        return heap.front().item;
+    }
+
+    /// @brief Calls a function with the key and the item of every queued entry, in no particular order.
+    template<typename Function>
+    void
+    forEach(Function &&function) const {
+        for(const Entry &entry : heap) {
+            function(entry.key, entry.item);
+        }
+    }
+
+    /// @brief Removes the lowest item. Its key can be queued again afterwards.
+    Item
+    pop() {
+        Item item = std::move(heap.front().item);
+        if(heap.size() > 1) {
+            heap.front() = std::move(heap.back());
+            heap.pop_back();
+            siftDown(0);
+        } else {
+            heap.pop_back();
+        }
+        return item;
+    }
+};
+
+}    // namespace cam::pathfinder
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <pathfinder/SearchCore.hpp>
+#include <pathfinder/SearchStats.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace cam::pathfinder {
+
+/// @brief Iterative deepening A* whose memory never grows past a byte budget, whatever the size of the map.
+///
+/// Uses the same policy objects as SearchCore. Every iteration is a depth first search pruning the nodes whose f
+/// exceeds a threshold, raised to the lowest pruned f for the next iteration, so only the current path is kept. A
+/// direct mapped transposition table of fixed size remembers the best score every (cell, direction) slot was reached
+/// with during the iteration, so the transpositions of a grid aren't searched again and again while it holds them. Half
+/// the budget goes to the table and the rest to the path: a node too deep for it ends the run, which reports that the
+/// bound was hit. A path found past that node wouldn't be known optimal, and searching on would only walk the paths
+/// that fit again and again, with a table too small to catch their transpositions, in a time growing exponentially with
+/// the depth.
+/// @tparam Cost Type of the scores.
+template<typename Cost>
+class IterativeDeepeningSearch {
+public:
+    using Node = SearchNode<Cost>;
+    using Path = std::vector<uint32_t>;
+
+    static constexpr Cost INFINITE = std::numeric_limits<Cost>::max();
+
+private:
+    struct Frame {
+        Node node;
+        int  next;    // next direction to try
+    };
+
+    struct Entry {
+        uint32_t slot;
+        uint32_t stamp;    // iteration the score was recorded in, 0 for an empty entry
+        Cost     g;
+    };
+
+    std::vector<Frame>   stack;
+    std::vector<Entry>   table;
+    uint32_t             mask       = 0;
+    uint32_t             generation = 0;
+    size_t               depth      = 0;          // deepest path that fits in the budget
+    size_t               budget     = 16 << 20;
+    Path                 found;
+    Cost                 best  = INFINITE;
+    bool                 hit   = false;
+    SearchStats         *stats = nullptr;
+    const TraceCallback *trace = nullptr;
+
+    /// @brief Sizes the table to the largest power of two fitting half the budget, and the path to the rest.
+    void
+    allocate() {
+        size_t entries = 1;
+        while(entries * 2 * sizeof(Entry) <= budget / 2) {
+            entries *= 2;
+        }
+        entries = entries * sizeof(Entry) <= budget / 2 ? entries : 0;
+        table.assign(entries, {0, 0, 0});
+        table.shrink_to_fit();
+        mask       = entries > 0 ? entries - 1 : 0;
+        generation = 0;
+
+        const size_t rest = budget - entries * sizeof(Entry);
+        depth             = rest > sizeof(uint32_t) ? (rest - sizeof(uint32_t)) / (sizeof(Frame) + sizeof(uint32_t)) : 0;
+        stack.clear();
+        stack.shrink_to_fit();
+        stack.reserve(depth);
+        found.clear();
+        found.shrink_to_fit();
+        found.reserve(depth + 1);
+    }
+
+    /// @brief Checks if a slot was already reached with a score not worse during this iteration, or records it.
+    ///
+    /// Every slot hashes to a pair of entries: the first one keeps the lowest score, as the nodes closest to the start
+    /// prune the largest subtrees, and the second one the latest slot, so the transpositions of the current area are
+    /// still caught once the first entries are taken.
+    inline bool
+    visited(uint32_t slot, Cost g) {
+        if(table.size() < 2) {
+            return false;
+        }
+        Entry *pair = &table[(slot * 2654435761u) & mask & ~1u];
+        for(int idx = 0; idx < 2; idx++) {
+            if(pair[idx].stamp == generation && pair[idx].slot == slot) {
+                if(pair[idx].g <= g) {
+                    return true;
+                }
+                pair[idx].g = g;
+                return false;
+            }
+        }
+        if(pair[0].stamp != generation || g <= pair[0].g) {
+            pair[1] = pair[0];
+            pair[0] = {slot, generation, g};
+        } else {
+            pair[1] = {slot, generation, g};
+        }
+        return false;
+    }
+
+    /// @brief Starts an iteration, forgetting the slots recorded by the previous ones.
+    inline void
+    nextGeneration() {
+        if(++generation == 0) {
+            std::fill(table.begin(), table.end(), Entry{0, 0, 0});
+            generation = 1;
+        }
+    }
+
+public:
+    /// @brief Collects statistics of the next runs, see SearchCore::instrument(). The open set size reported is the
+    /// depth of the current path.
+    inline void
+    instrument(SearchStats *stats, const TraceCallback *trace = nullptr) {
+        this->stats = stats;
+        this->trace = trace;
+    }
+
+    /// @brief Sets the memory the next runs may hold, in bytes. The buffers are resized at once.
+    void
+    setBudget(size_t bytes) {
+        budget = bytes;
+        allocate();
+    }
+
+    inline size_t
+    getBudget() const {
+        return budget;
+    }
+
+    /// @brief Memory held by the search buffers, in bytes. It never exceeds the budget.
+    inline size_t
+    bytes() const {
+        return stack.capacity() * sizeof(Frame) + table.capacity() * sizeof(Entry) + found.capacity() * sizeof(uint32_t);
+    }
+
+    /// @brief Searches an optimal path between two cells, or the best one fitting the budget.
+    /// @param policy Map specific operations, see SearchCore.
+    /// @param start Cell id where the search starts.
+    /// @param goal Cell id to reach.
+    /// @param g Initial score of the start cell.
+    /// @param dir Initial direction of the start cell.
+    /// @return True if the goal was reached.
+    template<typename Policy>
+    bool
+    run(const Policy &policy, uint32_t start, uint32_t goal, Cost g = 0, int dir = 0) {
+        if(stack.capacity() == 0 && table.empty()) {
+            allocate();
+        }
+        found.clear();
+        best = INFINITE;
+        hit  = false;
+
+        bool reached = start == goal;
+        if(reached) {
+            best = g;
+            found.push_back(start);
+        } else if(stats == nullptr) {
+            reached = search(SearchProbe<false>(nullptr, nullptr), policy, start, goal, g, dir);
+        } else {
+            measure(stats, &SearchStats::searchTime, [&]() { reached = search(SearchProbe<true>(stats, trace), policy, start, goal, g, dir); });
+        }
+
+        if(stats != nullptr) {
+            stats->bytes = bytes();
+            stats->budgetHits += hit;
+        }
+        return reached;
+    }
+
+    /// @brief Path found by the last run, as a list of cell ids from start to goal.
+    inline const Path &
+    path() const {
+        return found;
+    }
+
+    /// @brief Cost of the path found by the last run, INFINITE if the goal wasn't reached.
+    inline Cost
+    cost() const {
+        return best;
+    }
+
+    /// @brief True if the last run stopped at a path longer than the budget allows, so a missing path may exist.
+    inline bool
+    boundHit() const {
+        return hit;
+    }
+
+private:
+    template<typename Probe, typename Policy>
+    bool
+    search(Probe probe, const Policy &policy, uint32_t start, uint32_t goal, Cost g, int dir) {
+        const int NDIRS = policy.directions();
+        if(depth == 0) {
+            hit = true;
+            return false;
+        }
+
+        for(Cost threshold = g + policy.heuristic(start); threshold != INFINITE;) {
+            Cost next = INFINITE;
+            nextGeneration();
+            visited(start * NDIRS + dir, g);
+            stack.assign(1, {{threshold, g, start, dir, -1}, 0});
+            probe.push(stack.size());
+            probe.pop();
+            probe.expand(start);
+
+            while(!stack.empty()) {
+                Frame &top = stack.back();
+                if(top.next == NDIRS) {
+                    stack.pop_back();
+                    continue;
+                }
+
+                const int      idx  = top.next++;
+                const uint32_t cell = top.node.cell + policy.offset(idx);
+                if(!policy.canMove(top.node.cell, cell, idx)) {
+                    continue;
+                }
+
+                const Cost tentativeG = policy.step(top.node, cell, idx);
+                const Cost tentativeF = tentativeG + policy.heuristic(cell);
+                if(tentativeF > threshold) {
+                    next = std::min(next, tentativeF);
+                    continue;
+                }
+
+                // Every path of the previous iterations cost more than the threshold, so this one is optimal
+                if(cell == goal) {
+                    best = tentativeG;
+                    for(const Frame &frame : stack) {
+                        found.push_back(frame.node.cell);
+                    }
+                    found.push_back(goal);
+                    return true;
+                }
+
+                if(stack.size() == depth) {
+                    hit = true;
+                    return false;
+                }
+                if(visited(cell * NDIRS + idx, tentativeG)) {
+                    probe.skip();
+                    continue;
+                }
+                // Nodes are expanded as soon as they are pushed, the path being the open set of a depth first search
+                stack.push_back({{tentativeF, tentativeG, cell, idx, -1}, 0});
+                probe.push(stack.size());
+                probe.pop();
+                probe.expand(cell);
+            }
+            threshold = next;
+        }
+        return false;
+    }
+};
+
+}    // namespace cam::pathfinder
@@ -0,0 +1,293 @@
+#pragma once
+
+#include <pathfinder/SearchStats.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+namespace cam::pathfinder {
+
+/// @brief Jump Point Search for 4-connected grids where every move has the same cost.
+///
+/// Uses the same policy objects as SearchCore, but only its directions(), offset() and canMove() operations: the cost
+/// of a path is its number of moves. Symmetric paths are pruned by following a canonical order, so only a handful of
+/// jump points reach the open set and a single optimal path is found.
+/// @tparam Cost Type of the scores.
+template<typename Cost>
+class JumpPointSearch {
+public:
+    using Path = std::vector<uint32_t>;
+
+    static constexpr Cost     INFINITE = std::numeric_limits<Cost>::max();
+    static constexpr uint32_t NONE     = 0;    // cell id 0 is always a border cell
+
+private:
+    enum Direction { UP, RIGHT, DOWN, LEFT, COUNT };
+
+    struct Entry {
+        Cost     f;
+        Cost     g;
+        uint32_t cell;
+
+        bool
+        operator>(const Entry &other) const {
+            return f > other.f || (f == other.f && g < other.g);
+        }
+    };
+
+    std::vector<Entry>    openSet;
+    std::vector<uint32_t> stamps;
+    std::vector<Cost>     scores;
+    std::vector<uint32_t> parents;
+    std::vector<uint8_t>  arrivals;
+    uint32_t              generation = 0;
+    Path                  found;
+    Cost                  best  = INFINITE;
+    SearchStats          *stats = nullptr;
+    const TraceCallback  *trace = nullptr;
+
+    int dirs[COUNT];    // policy direction index of every move
+    int offsets[COUNT];
+    int goalX;
+    int goalY;
+    int stride;
+
+    template<typename Policy>
+    inline bool
+    walkable(const Policy &policy, uint32_t cell, int dir) const {
+        return policy.canMove(cell, cell + offsets[dir], dirs[dir]);
+    }
+
+    inline Cost
+    heuristic(uint32_t cell) const {
+        return std::abs((int)(cell % stride) - goalX) + std::abs((int)(cell / stride) - goalY);
+    }
+
+    /// @brief Moves horizontally until a jump point is found: the goal, or a cell whose vertical neighbor was blocked
+    /// on the previous cell, as the only optimal paths to that neighbor come through here.
+    template<typename Policy>
+    uint32_t
+    jumpHorizontal(const Policy &policy, uint32_t cell, int dir, uint32_t goal, int &steps) const {
+        for(steps = 1;; steps++) {
+            const uint32_t prev = cell;
+            if(!walkable(policy, prev, dir)) {
+                return NONE;
+            }
+            cell += offsets[dir];
+            if(cell == goal) {
+                return cell;
+            }
+            if((walkable(policy, cell, UP) && !walkable(policy, prev, UP)) || (walkable(policy, cell, DOWN) && !walkable(policy, prev, DOWN))) {
+                return cell;
+            }
+        }
+    }
+
+    /// @brief Moves vertically until a jump point is found. Besides the goal and the forced neighbors, any cell from
+    /// where a horizontal jump succeeds is a jump point too, as the canonical paths turn there.
+    template<typename Policy>
+    uint32_t
+    jumpVertical(const Policy &policy, uint32_t cell, int dir, uint32_t goal, int &steps) const {
+        int ignored;
+        for(steps = 1;; steps++) {
+            const uint32_t prev = cell;
+            if(!walkable(policy, prev, dir)) {
+                return NONE;
+            }
+            cell += offsets[dir];
+            if(cell == goal) {
+                return cell;
+            }
+            if((walkable(policy, cell, LEFT) && !walkable(policy, prev, LEFT)) || (walkable(policy, cell, RIGHT) && !walkable(policy, prev, RIGHT))) {
+                return cell;
+            }
+            if(jumpHorizontal(policy, cell, LEFT, goal, ignored) != NONE || jumpHorizontal(policy, cell, RIGHT, goal, ignored) != NONE) {
+                return cell;
+            }
+        }
+    }
+
+    /// @return True if the cell was queued.
+    inline bool
+    push(uint32_t cell, Cost g, uint32_t parent, int arrival) {
+        if(stamps[cell] == generation && scores[cell] <= g) {
+            // Reached again with the same score but another direction: expand it again trying every move, so neither
+            // canonical order loses its successors.
+            if(scores[cell] == g && arrivals[cell] != arrival && arrivals[cell] != COUNT) {
+                arrivals[cell] = COUNT;
+                openSet.push_back({g + heuristic(cell), g, cell});
+                std::push_heap(openSet.begin(), openSet.end(), std::greater<Entry>());
+                return true;
+            }
+            return false;
+        }
+        stamps[cell]   = generation;
+        scores[cell]   = g;
+        parents[cell]  = parent;
+        arrivals[cell] = arrival;
+        openSet.push_back({g + heuristic(cell), g, cell});
+        std::push_heap(openSet.begin(), openSet.end(), std::greater<Entry>());
+        return true;
+    }
+
+    template<typename Probe, typename Policy>
+    bool
+    search(Probe probe, const Policy &policy, uint32_t start, uint32_t goal) {
+        push(start, 0, start, COUNT);
+        probe.push(openSet.size());
+        while(!openSet.empty()) {
+            std::pop_heap(openSet.begin(), openSet.end(), std::greater<Entry>());
+            Entry current = openSet.back();
+            openSet.pop_back();
+            probe.pop();
+
+            if(current.g > scores[current.cell]) {
+                continue;
+            }
+            if(current.cell == goal) {
+                best = current.g;
+                return true;
+            }
+
+            // Canonical successors: straight on plus both turns, never going back. The start cell tries every move.
+            probe.expand(current.cell);
+            const int arrival = arrivals[current.cell];
+            for(int dir = 0; dir < COUNT; dir++) {
+                if(arrival != COUNT && dir == (arrival + 2) % COUNT) {
+                    continue;
+                }
+                int      steps = 0;
+                uint32_t jump  = (dir == LEFT || dir == RIGHT) ? jumpHorizontal(policy, current.cell, dir, goal, steps)
+                                                               : jumpVertical(policy, current.cell, dir, goal, steps);
+                if(jump == NONE) {
+                    continue;
+                }
+                if(push(jump, current.g + steps, current.cell, dir)) {
+                    probe.push(openSet.size());
+                } else {
+                    probe.skip();
+                }
+            }
+        }
+        return false;
+    }
+
+    void
+    rebuild(uint32_t start, uint32_t goal) {
+        found.clear();
+        for(uint32_t cell = goal; cell != start; cell = parents[cell]) {
+            const int dir  = (cell / stride == parents[cell] / stride) ? RIGHT : DOWN;
+            const int step = cell > parents[cell] ? offsets[dir] : -offsets[dir];
+            for(uint32_t it = cell; it != parents[cell]; it -= step) {
+                found.push_back(it);
+            }
+        }
+        found.push_back(start);
+        std::reverse(found.begin(), found.end());
+    }
+
+public:
+    /// @brief Collects statistics of the next runs, see SearchCore::instrument().
+    inline void
+    instrument(SearchStats *stats, const TraceCallback *trace = nullptr) {
+        this->stats = stats;
+        this->trace = trace;
+    }
+
+    /// @brief Memory held by the search buffers, in bytes.
+    inline size_t
+    bytes() const {
+        return openSet.capacity() * sizeof(Entry) + (stamps.capacity() + parents.capacity() + found.capacity()) * sizeof(uint32_t) +
+               scores.capacity() * sizeof(Cost) + arrivals.capacity();
+    }
+
+    /// @brief Checks if the policy directions are the four straight unit moves this search relies on.
+    template<typename Policy>
+    static bool
+    supports(const Policy &policy, int stride) {
+        if(policy.directions() != COUNT) {
+            return false;
+        }
+        const int expected[COUNT] = {-stride, 1, stride, -1};
+        for(int move = 0; move < COUNT; move++) {
+            bool present = false;
+            for(int idx = 0; idx < COUNT; idx++) {
+                present |= (policy.offset(idx) == expected[move]);
+            }
+            if(!present) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief Searches an optimal path between two cells.
+    /// @param policy Map specific operations, its directions must pass the supports() check.
+    /// @param cells Number of cell ids of the map.
+    /// @param stride Cell id offset between two consecutive rows.
+    /// @param start Cell id where the search starts.
+    /// @param goal Cell id to reach.
+    /// @return True if the goal was reached.
+    template<typename Policy>
+    bool
+    run(const Policy &policy, size_t cells, int stride, uint32_t start, uint32_t goal) {
+        const int expected[COUNT] = {-stride, 1, stride, -1};
+        for(int move = 0; move < COUNT; move++) {
+            offsets[move] = expected[move];
+            for(int idx = 0; idx < policy.directions(); idx++) {
+                if(policy.offset(idx) == expected[move]) {
+                    dirs[move] = idx;
+                }
+            }
+        }
+        this->stride = stride;
+        goalX        = goal % stride;
+        goalY        = goal / stride;
+
+        if(stamps.size() != cells) {
+            stamps.assign(cells, 0);
+            scores.resize(cells);
+            parents.resize(cells);
+            arrivals.resize(cells);
+            generation = 0;
+        }
+        if(++generation == 0) {
+            std::fill(stamps.begin(), stamps.end(), 0);
+            generation = 1;
+        }
+        openSet.clear();
+        found.clear();
+        best = INFINITE;
+
+        bool reached = false;
+        if(stats == nullptr) {
+            reached = search(SearchProbe<false>(nullptr, nullptr), policy, start, goal);
+        } else {
+            measure(stats, &SearchStats::searchTime, [&]() { reached = search(SearchProbe<true>(stats, trace), policy, start, goal); });
+        }
+        if(reached) {
+            measure(stats, &SearchStats::pathTime, [&]() { rebuild(start, goal); });
+        }
+        if(stats != nullptr) {
+            stats->bytes = bytes();
+        }
+        return reached;
+    }
+
+    /// @brief Path found by the last run, as a list of cell ids from start to goal.
+    inline const Path &
+    path() const {
+        return found;
+    }
+
+    /// @brief Cost of the path found by the last run, INFINITE if the goal wasn't reached.
+    inline Cost
+    cost() const {
+        return best;
+    }
+};
+
+}    // namespace cam::pathfinder
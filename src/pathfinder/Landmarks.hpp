@@ -0,0 +1,162 @@
+#pragma once
+
+#include <pathfinder/IndexedHeap.hpp>
+#include <pathfinder/Policies.hpp>
+#include <pathfinder/SearchCore.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cam::pathfinder {
+
+/// @brief Distances from a few landmark cells to every cell of a map, giving a much tighter heuristic than the plain
+/// distance on maps with many obstacles (ALT, or differential heuristic).
+///
+/// By the triangle inequality, the cost between two cells is at least the difference of their distances to any
+/// landmark, so the best landmark bounds the cost to the goal even around walls the plain distance ignores. Landmarks
+/// are picked far from each other, each one the farthest cell from those already picked. The tables take one Distance
+/// per cell and landmark, stored cell by cell so an estimation reads a single cache line, and the number of landmarks
+/// is cut down to fit a memory budget.
+///
+/// Moves must be reversible with the same cost, and their cost must not depend on the direction the cell was reached
+/// from. Distances too large for the Distance type are saturated, which keeps the heuristic admissible and consistent.
+/// @tparam Score Score type of the cost policy.
+/// @tparam Distance Type stored in the tables.
+template<typename Score, typename Distance = std::conditional_t<std::is_integral_v<Score>, uint16_t, Score>>
+class Landmarks {
+    static constexpr Distance CAP = std::numeric_limits<Distance>::max();
+
+    std::vector<Distance> table;    // distances of every landmark to a cell, cell by cell
+    std::vector<uint32_t> cells;
+    size_t                count = 0;
+
+    /// @brief Dijkstra from a cell over the whole map.
+    template<typename Map, typename Neighborhood, typename Cost>
+    static void
+    distances(const Map &map, const Neighborhood &neighborhood, const Cost &costs, uint32_t source, std::vector<Score> &scores) {
+        IndexedHeap<SearchNode<Score>> openSet;
+        openSet.reset(map.size());
+        scores.assign(map.size(), SearchCore<Score>::INFINITE);
+        scores[source] = 0;
+        openSet.push(source, {0, 0, source, 0, -1});
+        while(!openSet.empty()) {
+            const SearchNode<Score> node = openSet.pop();
+            for(int dir = 0; dir < neighborhood.size(); dir++) {
+                const uint32_t next = node.cell + neighborhood.offset(map, dir);
+                if(!neighborhood.canMove(map, node.cell, next, dir)) {
+                    continue;
+                }
+                const Score g = costs.step(map, node, next, dir);
+                if(g < scores[next]) {
+                    scores[next] = g;
+                    openSet.push(next, {g, g, next, dir, -1});
+                }
+            }
+        }
+    }
+
+public:
+    Landmarks() = default;
+
+    /// @brief Picks the landmarks of a map and computes their tables.
+    /// @param count Maximum number of landmarks.
+    /// @param budget Maximum size of the tables, in bytes.
+    template<typename Map, typename Neighborhood = FourNeighborhood, typename Cost = UnitCost>
+    Landmarks(const Map &map, size_t count, size_t budget, const Neighborhood &neighborhood = {}, const Cost &costs = {}) {
+        count = std::min(count, budget / (map.size() * sizeof(Distance)));
+        uint32_t first = map.find(EMPTY);
+        if(first == 0) {
+            first = map.find(START);
+        }
+        if(count == 0 || first == 0) {
+            return;
+        }
+
+        // Distance to the closest landmark picked so far, the next one is the farthest reachable cell
+        std::vector<Score> scores;
+        std::vector<Score> closest;
+        distances(map, neighborhood, costs, first, closest);
+        std::vector<std::vector<Distance>> columns;
+        while(cells.size() < count) {
+            uint32_t farthest = 0;
+            for(uint32_t cell = 0; cell < map.size(); cell++) {
+                if(closest[cell] != SearchCore<Score>::INFINITE && (farthest == 0 || closest[cell] > closest[farthest])) {
+                    farthest = cell;
+                }
+            }
+            if(farthest == 0 || (!cells.empty() && closest[farthest] == 0)) {
+                break;
+            }
+
+            cells.push_back(farthest);
+            distances(map, neighborhood, costs, farthest, scores);
+            auto &column = columns.emplace_back(map.size());
+            for(uint32_t cell = 0; cell < map.size(); cell++) {
+                column[cell]  = scores[cell] < (Score)CAP ? (Distance)scores[cell] : CAP;
+                closest[cell] = cells.size() == 1 ? scores[cell] : std::min(closest[cell], scores[cell]);
+            }
+        }
+
+        this->count = cells.size();
+        table.resize(map.size() * this->count);
+        for(size_t landmark = 0; landmark < this->count; landmark++) {
+            for(uint32_t cell = 0; cell < map.size(); cell++) {
+                table[cell * this->count + landmark] = columns[landmark][cell];
+            }
+        }
+    }
+
+    /// @brief Lower bound of the cost between two cells.
+    inline Score
+    estimate(uint32_t cell, uint32_t goal) const {
+        const Distance *from  = table.data() + cell * count;
+        const Distance *to    = table.data() + goal * count;
+        Distance        bound = 0;
+        for(size_t landmark = 0; landmark < count; landmark++) {
+            bound = std::max<Distance>(bound, from[landmark] > to[landmark] ? from[landmark] - to[landmark] : to[landmark] - from[landmark]);
+        }
+        return (Score)bound;
+    }
+
+    /// @brief Number of landmarks that fitted in the budget.
+    inline size_t
+    size() const {
+        return count;
+    }
+
+    /// @brief Cell id of a landmark.
+    inline uint32_t
+    landmark(size_t index) const {
+        return cells[index];
+    }
+
+    /// @brief Memory taken by the tables, in bytes.
+    inline size_t
+    bytes() const {
+        return table.size() * sizeof(Distance);
+    }
+};
+
+/// @brief Heuristic policy reading shared Landmarks tables, never worse than the base heuristic.
+/// @tparam Table Landmarks type, matching the score of the cost policy.
+/// @tparam Base Heuristic taking the signed distance to the goal, used where it beats the landmarks.
+template<typename Table, typename Base = ManhattanHeuristic>
+struct LandmarkHeuristic {
+    std::shared_ptr<const Table> landmarks;
+    Base                         base;
+
+    template<typename Map>
+    inline auto
+    operator()(const Map &map, uint32_t cell, uint32_t goal) const {
+        using Score       = std::common_type_t<decltype(estimate(base, map, cell, goal)), decltype(landmarks->estimate(cell, goal))>;
+        const Score plain = estimate(base, map, cell, goal);
+        return landmarks ? std::max(plain, (Score)landmarks->estimate(cell, goal)) : plain;
+    }
+};
+
+}    // namespace cam::pathfinder
@@ -0,0 +1,210 @@
+#include "MapLoader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#if defined(__AVX2__)
+#    include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define TOOLIT_SSE2
+#endif
+
+#if !defined(_WIN32)
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace cam::pathfinder {
+
+namespace {
+
+// Length of a row without its line ending
+size_t
+rowLength(const char *row, const char *last) {
+    const char *newline = static_cast<const char *>(std::memchr(row, '\n', last - row));
+    const char *end     = newline != nullptr ? newline : last;
+    return (end > row && end[-1] == '\r' ? end - 1 : end) - row;
+}
+
+// Index of the lowest bit set
+inline int
+lowestBit(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+}    // namespace
+
+void
+MapLoader::parseRow(Grid &grid, int y, const char *row, size_t length, uint32_t &start, uint32_t &end) {
+    length = std::min(length, (size_t)grid.getWidth());
+
+    const uint32_t first = grid.index(0, y);
+    uint8_t       *cells = grid.cells.data() + first;
+    size_t         x     = 0;
+
+    // Every lane is decoded at once: '.', 'S' and 'E' to their types, '1' to '9' to an EMPTY cell with that weight, and
+    // anything else to BLOCK. Lanes matching START or END are only looked at while the first one isn't known.
+#if defined(__AVX2__)
+    const __m256i dot   = _mm256_set1_epi8('.');
+    const __m256i s     = _mm256_set1_epi8('S');
+    const __m256i e     = _mm256_set1_epi8('E');
+    const __m256i one   = _mm256_set1_epi8('1');
+    const __m256i eight = _mm256_set1_epi8(8);
+    const __m256i block = _mm256_set1_epi8(BLOCK);
+    const __m256i mask  = _mm256_set1_epi8((char)~Grid::TYPE_MASK);
+    __m256i       heavy = _mm256_setzero_si256();
+    for(; x + 32 <= length; x += 32) {
+        const __m256i chars   = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + x));
+        const __m256i isDot   = _mm256_cmpeq_epi8(chars, dot);
+        const __m256i isStart = _mm256_cmpeq_epi8(chars, s);
+        const __m256i isEnd   = _mm256_cmpeq_epi8(chars, e);
+        const __m256i digit   = _mm256_sub_epi8(chars, one);
+        const __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, eight), digit);
+        const __m256i weight  = _mm256_and_si256(_mm256_slli_epi16(digit, Grid::WEIGHT_SHIFT), mask);
+        const __m256i known   = _mm256_or_si256(_mm256_or_si256(isDot, isStart), _mm256_or_si256(isEnd, isDigit));
+
+        __m256i value = _mm256_andnot_si256(known, block);
+        value         = _mm256_or_si256(value, _mm256_and_si256(isStart, _mm256_set1_epi8(START)));
+        value         = _mm256_or_si256(value, _mm256_and_si256(isEnd, _mm256_set1_epi8(END)));
+        value         = _mm256_or_si256(value, _mm256_and_si256(isDigit, weight));
+        heavy         = _mm256_or_si256(heavy, _mm256_and_si256(isDigit, weight));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(cells + x), value);
+
+        if(start == 0 && !_mm256_testz_si256(isStart, isStart)) {
+            start = first + x + lowestBit(_mm256_movemask_epi8(isStart));
+        }
+        if(end == 0 && !_mm256_testz_si256(isEnd, isEnd)) {
+            end = first + x + lowestBit(_mm256_movemask_epi8(isEnd));
+        }
+    }
+    grid.weighted |= !_mm256_testz_si256(heavy, heavy);
+#elif defined(TOOLIT_SSE2)
+    const __m128i dot   = _mm_set1_epi8('.');
+    const __m128i s     = _mm_set1_epi8('S');
+    const __m128i e     = _mm_set1_epi8('E');
+    const __m128i one   = _mm_set1_epi8('1');
+    const __m128i eight = _mm_set1_epi8(8);
+    const __m128i block = _mm_set1_epi8(BLOCK);
+    const __m128i mask  = _mm_set1_epi8((char)~Grid::TYPE_MASK);
+    __m128i       heavy = _mm_setzero_si128();
+    for(; x + 16 <= length; x += 16) {
+        const __m128i chars   = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + x));
+        const __m128i isDot   = _mm_cmpeq_epi8(chars, dot);
+        const __m128i isStart = _mm_cmpeq_epi8(chars, s);
+        const __m128i isEnd   = _mm_cmpeq_epi8(chars, e);
+        const __m128i digit   = _mm_sub_epi8(chars, one);
+        const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, eight), digit);
+        const __m128i weight  = _mm_and_si128(_mm_slli_epi16(digit, Grid::WEIGHT_SHIFT), mask);
+        const __m128i known   = _mm_or_si128(_mm_or_si128(isDot, isStart), _mm_or_si128(isEnd, isDigit));
+
+        __m128i value = _mm_andnot_si128(known, block);
+        value         = _mm_or_si128(value, _mm_and_si128(isStart, _mm_set1_epi8(START)));
+        value         = _mm_or_si128(value, _mm_and_si128(isEnd, _mm_set1_epi8(END)));
+        value         = _mm_or_si128(value, _mm_and_si128(isDigit, weight));
+        heavy         = _mm_or_si128(heavy, _mm_and_si128(isDigit, weight));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(cells + x), value);
+
+        if(start == 0) {
+            if(const int found = _mm_movemask_epi8(isStart); found != 0) {
+                start = first + x + lowestBit(found);
+            }
+        }
+        if(end == 0) {
+            if(const int found = _mm_movemask_epi8(isEnd); found != 0) {
+                end = first + x + lowestBit(found);
+            }
+        }
+    }
+    grid.weighted |= _mm_movemask_epi8(_mm_cmpeq_epi8(heavy, _mm_setzero_si128())) != 0xFFFF;
+#endif
+
+    for(uint32_t cell = first + x; x < length; x++, cell++) {
+        int        weight;
+        const Type type = cellType(row[x], weight);
+        grid.set(cell, type);
+        if(weight > 1) {
+            grid.setWeight(cell, weight);
+        } else if(type == START && start == 0) {
+            start = cell;
+        } else if(type == END && end == 0) {
+            end = cell;
+        }
+    }
+}
+
+bool
+MapLoader::parse(const char *data, size_t size, LoadedMap &map) {
+    const char *last = data + size;
+    if(size > 0 && last[-1] == '\n') {
+        last--;
+    }
+    const size_t width = data != nullptr ? rowLength(data, last) : 0;
+    if(width == 0) {
+        return false;
+    }
+
+    // Counting the rows only looks for line endings, the cells are read once while filling the grid
+    size_t height = 1;
+    for(const char *it = data; (it = static_cast<const char *>(std::memchr(it, '\n', last - it))) != nullptr; it++) {
+        height++;
+    }
+
+    map.grid  = Grid((int)width, (int)height, BLOCK);
+    map.start = 0;
+    map.end   = 0;
+    const char *row = data;
+    for(int y = 0; y < (int)height; y++) {
+        parseRow(map.grid, y, row, rowLength(row, last), map.start, map.end);
+        const char *newline = static_cast<const char *>(std::memchr(row, '\n', last - row));
+        row                 = newline != nullptr ? newline + 1 : last;
+    }
+    return true;
+}
+
+bool
+MapLoader::load(const std::string &path, LoadedMap &map) {
+#if !defined(_WIN32)
+    const int file = open(path.c_str(), O_RDONLY);
+    if(file < 0) {
+        return false;
+    }
+    struct stat info;
+    if(fstat(file, &info) != 0 || info.st_size == 0) {
+        close(file);
+        return false;
+    }
+
+    const size_t size   = info.st_size;
+    void        *buffer = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if(buffer == MAP_FAILED) {
+        return false;
+    }
+    madvise(buffer, size, MADV_SEQUENTIAL);
+    const bool loaded = parse(static_cast<const char *>(buffer), size, map);
+    munmap(buffer, size);
+    return loaded;
+#else
+    std::ifstream file(path, std::ifstream::in | std::ifstream::binary | std::ifstream::ate);
+    if(!file.is_open()) {
+        return false;
+    }
+    std::vector<char> buffer((size_t)file.tellg());
+    file.seekg(0);
+    file.read(buffer.data(), buffer.size());
+    return parse(buffer.data(), buffer.size(), map);
+#endif
+}
+
+}    // namespace cam::pathfinder
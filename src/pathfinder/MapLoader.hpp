@@ -0,0 +1,60 @@
+#pragma once
+
+#include <pathfinder/Grid.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace cam::pathfinder {
+
+/// @brief Map built by MapLoader, with the first START and END cells found while scanning it.
+struct LoadedMap {
+    Grid     grid;
+    uint32_t start = 0;    // cell id of the first START cell, 0 if there is none
+    uint32_t end   = 0;    // cell id of the first END cell, 0 if there is none
+};
+
+/// @brief Builds a Grid straight from the text of a map, without splitting it into rows first.
+///
+/// Uses the characters of PathFinder::parse(). The width is the length of the first row, shorter rows are padded with
+/// walls and longer ones cut. Both '\n' and "\r\n" line endings are accepted, and a trailing line ending is optional.
+class MapLoader {
+public:
+    /// @brief Type and terrain weight of a map character.
+    static inline Type
+    cellType(char c, int &weight) {
+        weight = 1;
+        switch(c) {
+            case '.':
+                return EMPTY;
+            case 'S':
+                return START;
+            case 'E':
+                return END;
+            default:
+                if(c >= '1' && c <= '9') {
+                    weight = c - '0';
+                    return EMPTY;
+                }
+                return BLOCK;
+        }
+    }
+
+    /// @brief Fills a row of a grid from its characters, 16 or 32 at a time with SSE2 or AVX2 where the build targets
+    /// them. Characters past the width of the grid are ignored.
+    /// @param start Cell id of the first START cell, updated if it is 0 and the row holds one.
+    /// @param end Cell id of the first END cell, updated if it is 0 and the row holds one.
+    static void parseRow(Grid &grid, int y, const char *row, size_t length, uint32_t &start, uint32_t &end);
+
+    /// @brief Parses a map from a memory buffer. A first scan only looks for line endings to size the grid, then every
+    /// cell is read once while filling it.
+    /// @return False if the buffer holds no map.
+    static bool parse(const char *data, size_t size, LoadedMap &map);
+
+    /// @brief Parses a map file, memory mapping it where the platform allows it.
+    /// @return False if the file can't be read or holds no map.
+    static bool load(const std::string &path, LoadedMap &map);
+};
+
+}    // namespace cam::pathfinder
@@ -0,0 +1,533 @@
+#pragma once
+
+#include <pathfinder/IndexedHeap.hpp>
+#include <pathfinder/SearchCore.hpp>
+#include <pathfinder/SearchStats.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace cam::pathfinder {
+
+/// @brief Simplified memory-bounded A* (SMA*), an A* over a fixed number of nodes sized from a byte budget.
+///
+/// Uses the same policy objects as SearchCore. Nodes live in a preallocated pool and are looked up by (cell, direction)
+/// slot in an open addressing table, so the memory held is known before searching. Once the pool is full, the worst
+/// leaf (highest f, then shallowest) is evicted to make room, and its parent remembers the lowest f of the children it
+/// forgot: when its last child is gone, the parent is queued again with that f, so the forgotten branch is regenerated
+/// only once every better node was tried. Every node takes the highest f of its ancestors, so the f of the queued nodes
+/// never decreases and the first arrival at the goal is optimal among the paths whose nodes fit the pool at once. A
+/// node other than the goal as deep as the pool is large can't hold any child, so its f is infinite: branches that
+/// can't fit back up infinity, and the search gives up once the start does instead of regenerating them forever. To
+/// keep it from enumerating every path short enough to fit, a lossy table recalls the lowest score and depth each cell
+/// was generated with, and a successor both no cheaper and no shallower than one of them, worse in one, isn't generated
+/// again. Paths forgotten from the table may still be tried again exponentially many times when the budget is short of
+/// the path, so a run gives up after expanding EXPANSIONS_PER_NODE times as many nodes as the pool holds.
+/// @tparam Cost Type of the scores.
+template<typename Cost>
+class MemoryBoundedSearch {
+public:
+    using Path = std::vector<uint32_t>;
+
+    static constexpr Cost INFINITE = std::numeric_limits<Cost>::max();
+
+private:
+    static constexpr int    EMPTY_BUCKET        = -1;
+    static constexpr int    FREED               = -2;    // parent of a pool node not in use
+    static constexpr size_t SEEN_PER_BUCKET     = 2;     // entries of the seen table, the two ways sharing a hash
+    static constexpr size_t EXPANSIONS_PER_NODE = 64;    // expansions a run may do per pool node before giving up
+
+    struct Node {
+        Cost     f;
+        Cost     g;
+        Cost     forgotten;    // lowest f of the evicted children, INFINITE if none
+        uint32_t cell;
+        int      dir;
+        int      parent;
+        int      children;     // children held by the pool
+        uint32_t depth;        // nodes from the start to this one, both included
+    };
+
+    /// @brief Lowest score and depth a key was generated with during the run.
+    struct Seen {
+        uint32_t key;
+        uint32_t depth;    // 0 if unused, successors being at least 2 nodes deep
+        Cost     g;
+    };
+
+    /// @brief Queued leaf, lowest f on top, breaking ties towards the deepest one.
+    struct Best {
+        Cost f;
+        Cost g;
+        int  node;
+
+        bool
+        operator>(const Best &other) const {
+            return f > other.f || (f == other.f && g < other.g);
+        }
+    };
+
+    /// @brief Queued leaf, highest f on top, breaking ties towards the shallowest one.
+    struct Worst {
+        Cost f;
+        Cost g;
+        int  node;
+
+        bool
+        operator>(const Worst &other) const {
+            return f < other.f || (f == other.f && g > other.g);
+        }
+    };
+
+    std::vector<Node>    pool;
+    std::vector<Cost>    remembered;    // f of the evicted successors of every pool node, by direction, 0 if unknown
+    std::vector<int>     unused;        // freed pool nodes
+    std::vector<int>     buckets;       // pool node of every slot, by linear probing
+    std::vector<Seen>    seen;          // two ways per hash, a new key replacing the deepest one
+    IndexedHeap<Best>    openSet;
+    IndexedHeap<Worst>   leaves;
+    Path                 found;
+    size_t               budget    = 16 << 20;
+    size_t               capacity  = 0;
+    uint32_t             mask      = 0;
+    int                  ndirs     = 1;
+    bool                 perCell   = false;
+    int                  expanding = -1;    // node whose successors are being generated
+    Cost                 best      = INFINITE;
+    bool                 hit       = false;
+    SearchStats         *stats     = nullptr;
+    const TraceCallback *trace     = nullptr;
+
+    /// @brief Memory taken by every node of the pool, in its own buffers and the queues, bucket and seen tables apart.
+    inline size_t
+    nodeBytes() const {
+        return sizeof(Node) + ndirs * sizeof(Cost) + sizeof(int) + sizeof(uint32_t) + sizeof(std::pair<Best, uint32_t>) +
+               sizeof(std::pair<Worst, uint32_t>) + 4 * sizeof(uint32_t);
+    }
+
+    /// @brief Sizes the bucket and seen tables to the largest power of two leaving room for half as many nodes, and the
+    /// pool to the rest of the budget. The path holds a cell more than the pool, for a query whose start is its goal.
+    void
+    allocate() {
+        const size_t room  = budget >= sizeof(uint32_t) ? budget - sizeof(uint32_t) : 0;
+        const size_t entry = sizeof(int) + SEEN_PER_BUCKET * sizeof(Seen);
+
+        size_t count = 2;
+        while(2 * count * entry + count * nodeBytes() <= room) {
+            count *= 2;
+        }
+        count    = count * entry + count / 2 * nodeBytes() <= room ? count : 0;
+        capacity = count > 0 ? std::min(count / 2, (room - count * entry) / nodeBytes()) : 0;
+        mask     = count > 0 ? count - 1 : 0;
+
+        buckets    = std::vector<int>(count, EMPTY_BUCKET);
+        seen       = std::vector<Seen>(count * SEEN_PER_BUCKET);
+        pool       = std::vector<Node>();
+        remembered = std::vector<Cost>(capacity * ndirs);
+        unused     = std::vector<int>();
+        found      = Path();
+        openSet    = IndexedHeap<Best>();
+        leaves     = IndexedHeap<Worst>();
+        pool.reserve(capacity);
+        unused.reserve(capacity);
+        found.reserve(budget >= sizeof(uint32_t) ? capacity + 1 : 0);
+        openSet.reset(capacity);
+        openSet.reserve(capacity);
+        leaves.reset(capacity);
+        leaves.reserve(capacity);
+    }
+
+    /// @brief Key of a node in the table: its cell when moves don't depend on the direction it was reached from, as
+    /// a second node on a held cell is never better, or its (cell, direction) slot otherwise.
+    inline uint32_t
+    slot(int node) const {
+        return perCell ? pool[node].cell : pool[node].cell * ndirs + pool[node].dir;
+    }
+
+    inline uint32_t
+    home(uint32_t slot) const {
+        return (slot * 2654435761u) & mask;
+    }
+
+    int
+    find(uint32_t key) const {
+        for(uint32_t idx = home(key); buckets[idx] != EMPTY_BUCKET; idx = (idx + 1) & mask) {
+            if(slot(buckets[idx]) == key) {
+                return buckets[idx];
+            }
+        }
+        return EMPTY_BUCKET;
+    }
+
+    void
+    insert(int node) {
+        uint32_t idx = home(slot(node));
+        while(buckets[idx] != EMPTY_BUCKET) {
+            idx = (idx + 1) & mask;
+        }
+        buckets[idx] = node;
+    }
+
+    /// @brief Removes a node from the table, shifting back the following ones so no lookup stops early.
+    void
+    erase(int node) {
+        uint32_t hole = home(slot(node));
+        while(buckets[hole] != node) {
+            hole = (hole + 1) & mask;
+        }
+        buckets[hole] = EMPTY_BUCKET;
+        for(uint32_t idx = (hole + 1) & mask; buckets[idx] != EMPTY_BUCKET; idx = (idx + 1) & mask) {
+            const uint32_t wanted = home(slot(buckets[idx]));
+            const bool     stays  = hole < idx ? (hole < wanted && wanted <= idx) : (hole < wanted || wanted <= idx);
+            if(!stays) {
+                buckets[hole] = buckets[idx];
+                buckets[idx]  = EMPTY_BUCKET;
+                hole          = idx;
+            }
+        }
+    }
+
+    /// @brief Empties the table of the nodes left by the previous run. Every cluster of the table holds home buckets
+    /// of live nodes only, so clearing from each home until an empty bucket clears them all without touching the rest.
+    void
+    clearBuckets() {
+        for(int node = 0; node < (int)pool.size(); node++) {
+            if(pool[node].parent == FREED) {
+                continue;
+            }
+            for(uint32_t idx = home(slot(node)); buckets[idx] != EMPTY_BUCKET; idx = (idx + 1) & mask) {
+                buckets[idx] = EMPTY_BUCKET;
+            }
+        }
+    }
+
+    /// @brief Checks if a key was already generated with both a score and a depth not higher than the given ones, one
+    /// of them lower, and records them otherwise.
+    /// @return True if the key was dominated, so nothing reachable from it is cheaper or fits the pool better.
+    bool
+    dominated(uint32_t key, Cost g, uint32_t depth) {
+        Seen *const set = &seen[(uint32_t)(((uint64_t)key * 0x9E3779B97F4A7C15ull) >> 32) & (seen.size() - 2)];
+        Seen       *entry = set[1].depth > set[0].depth ? &set[1] : &set[0];
+        for(int way = 0; way < 2; way++) {
+            if(set[way].depth > 0 && set[way].key == key) {
+                entry = &set[way];
+                if(entry->g <= g && entry->depth <= depth) {
+                    return entry->g < g || entry->depth < depth;
+                }
+                if(g > entry->g || depth > entry->depth) {
+                    return false;
+                }
+                break;
+            }
+            if(set[way].depth == 0) {
+                entry = &set[way];
+            }
+        }
+        *entry = {key, depth, g};
+        return false;
+    }
+
+    template<typename Probe>
+    inline void
+    queue(Probe &probe, int node) {
+        const Node &it = pool[node];
+        openSet.push(node, {it.f, it.g, node});
+        leaves.push(node, {it.f, it.g, node});
+        probe.push(openSet.size());
+    }
+
+    /// @brief Removes a child from its parent, queueing the parent again with the f it backed up once it has no child.
+    template<typename Probe>
+    void
+    detach(Probe &probe, int node) {
+        const int parent = pool[node].parent;
+        if(parent < 0) {
+            return;
+        }
+        Node &it = pool[parent];
+        it.children--;
+        if(it.children == 0 && parent != expanding) {
+            it.f = it.forgotten;
+            queue(probe, parent);
+        }
+    }
+
+    /// @brief Frees a queued leaf, its parent remembering its f.
+    template<typename Probe>
+    void
+    evict(Probe &probe, int node) {
+        openSet.remove(node);
+        leaves.remove(node);
+        erase(node);
+        if(const int parent = pool[node].parent; parent >= 0) {
+            pool[parent].forgotten                      = std::min(pool[parent].forgotten, pool[node].f);
+            remembered[parent * ndirs + pool[node].dir] = pool[node].f;
+        }
+        detach(probe, node);
+        pool[node].parent = FREED;
+        unused.push_back(node);
+    }
+
+    /// @return A free pool node, knowing nothing about its successors, or -1 once the pool is full.
+    inline int
+    allocateNode() {
+        int node = -1;
+        if(!unused.empty()) {
+            node = unused.back();
+            unused.pop_back();
+        } else if(pool.size() < capacity) {
+            pool.emplace_back();
+            node = pool.size() - 1;
+        }
+        if(node >= 0) {
+            std::fill_n(remembered.begin() + node * ndirs, ndirs, 0);
+        }
+        return node;
+    }
+
+public:
+    /// @brief Collects statistics of the next runs, see SearchCore::instrument().
+    inline void
+    instrument(SearchStats *stats, const TraceCallback *trace = nullptr) {
+        this->stats = stats;
+        this->trace = trace;
+    }
+
+    /// @brief Sets the memory the next runs may hold, in bytes. The buffers are resized at once.
+    void
+    setBudget(size_t bytes) {
+        budget = bytes;
+        allocate();
+    }
+
+    inline size_t
+    getBudget() const {
+        return budget;
+    }
+
+    /// @brief Number of nodes the pool holds with the current budget.
+    inline size_t
+    nodes() const {
+        return capacity;
+    }
+
+    /// @brief Memory held by the search buffers, in bytes. It never exceeds the budget.
+    inline size_t
+    bytes() const {
+        return pool.capacity() * sizeof(Node) + remembered.capacity() * sizeof(Cost) + (unused.capacity() + buckets.capacity()) * sizeof(int) +
+               seen.capacity() * sizeof(Seen) + found.capacity() * sizeof(uint32_t) + openSet.bytes() + leaves.bytes();
+    }
+
+    /// @brief Searches an optimal path between two cells, or the best one whose nodes fit the budget.
+    /// @param policy Map specific operations, see SearchCore.
+    /// @param start Cell id where the search starts.
+    /// @param goal Cell id to reach.
+    /// @param g Initial score of the start cell.
+    /// @param dir Initial direction of the start cell.
+    /// @return True if the goal was reached.
+    template<typename Policy>
+    bool
+    run(const Policy &policy, uint32_t start, uint32_t goal, Cost g = 0, int dir = 0) {
+        // The pool remembers something about every direction, so it is sized again for another number of them
+        if(policy.directions() != ndirs || (buckets.empty() && capacity == 0)) {
+            ndirs = policy.directions();
+            allocate();
+        }
+        clearBuckets();
+        perCell = !policy.directional();
+        std::fill(seen.begin(), seen.end(), Seen{});
+        pool.clear();
+        unused.clear();
+        openSet.reset(capacity);
+        leaves.reset(capacity);
+        found.clear();
+        best      = INFINITE;
+        hit       = false;
+        expanding = -1;
+
+        bool reached = start == goal && found.capacity() > 0;
+        if(reached) {
+            best = g;
+            found.push_back(start);
+        } else if(start == goal || capacity == 0) {
+            hit = true;
+        } else if(stats == nullptr) {
+            reached = search(SearchProbe<false>(nullptr, nullptr), policy, start, goal, g, dir);
+        } else {
+            measure(stats, &SearchStats::searchTime, [&]() { reached = search(SearchProbe<true>(stats, trace), policy, start, goal, g, dir); });
+        }
+
+        if(stats != nullptr) {
+            stats->bytes = bytes();
+            stats->budgetHits += hit;
+        }
+        return reached;
+    }
+
+    /// @brief Path found by the last run, as a list of cell ids from start to goal.
+    inline const Path &
+    path() const {
+        return found;
+    }
+
+    /// @brief Cost of the path found by the last run, INFINITE if the goal wasn't reached.
+    inline Cost
+    cost() const {
+        return best;
+    }
+
+    /// @brief True if the last run filled the pool and evicted or dropped nodes, so the path found may not be optimal
+    /// when it is as long as the pool, and a missing path may exist.
+    inline bool
+    boundHit() const {
+        return hit;
+    }
+
+private:
+    /// @brief Keeps the cost of the path and its cells, the ones up to a pool node coming before any already held.
+    void
+    finish(int node, Cost cost) {
+        best = cost;
+        for(int it = node; it >= 0; it = pool[it].parent) {
+            found.push_back(pool[it].cell);
+        }
+        std::reverse(found.begin(), found.end());
+    }
+
+    template<typename Probe, typename Policy>
+    bool
+    search(Probe probe, const Policy &policy, uint32_t start, uint32_t goal, Cost g, int dir) {
+        const int root = allocateNode();
+        pool[root]     = {g + policy.heuristic(start), g, INFINITE, start, dir, -1, 0, 1};
+        insert(root);
+        queue(probe, root);
+
+        size_t expansions = 0;
+        while(!openSet.empty()) {
+            // Leaves left without any successor are evicted, so their ancestors back up the f of the other branches
+            const Best top = openSet.top();
+            if(top.f == INFINITE) {
+                if(pool[top.node].parent < 0) {
+                    return false;
+                }
+                evict(probe, top.node);
+                continue;
+            }
+
+            // Searches finding their path regenerate far fewer nodes, a run going past that only thrashes the pool
+            if(++expansions > capacity * EXPANSIONS_PER_NODE) {
+                hit = true;
+                return false;
+            }
+
+            const int node = top.node;
+            openSet.pop();
+            leaves.remove(node);
+            probe.pop();
+            if(pool[node].cell == goal) {
+                finish(node, pool[node].g);
+                return true;
+            }
+
+            probe.expand(pool[node].cell);
+            expanding            = node;
+            pool[node].forgotten = INFINITE;
+
+            const Node             current = pool[node];
+            const SearchNode<Cost> from{current.f, current.g, current.cell, current.dir, current.parent};
+            for(int idx = 0; idx < ndirs; idx++) {
+                const uint32_t next = current.cell + policy.offset(idx);
+                if(!policy.canMove(current.cell, next, idx)) {
+                    continue;
+                }
+
+                // A successor filling the rest of the pool could never hold a child, so unless it is the goal its f is
+                // infinite, as is the one of a successor whose whole branch was tried already. Neither is generated, so
+                // a node whose successors all lead nowhere backs up infinity.
+                const uint32_t depth      = current.depth + 1;
+                const Cost     memory     = remembered[node * ndirs + idx];
+                const Cost     tentativeG = policy.step(from, next, idx);
+                if(memory == INFINITE) {
+                    probe.skip();
+                    continue;
+                }
+                if(next != goal && depth >= capacity) {
+                    hit = true;
+                    probe.skip();
+                    continue;
+                }
+                // The f a successor backed up before being evicted is kept, so its branch is only tried again past it
+                const Cost tentativeF = std::max({current.f, tentativeG + policy.heuristic(next), memory});
+
+                // A queued leaf reached with a lower score moves under this node, any other node held is kept. Held
+                // nodes include the ones of the current path, so walking back to one of its cells is rejected here.
+                if(const int held = find(perCell ? next : next * ndirs + idx); held >= 0) {
+                    if(pool[held].g <= tentativeG || !openSet.contains(held)) {
+                        probe.skip();
+                        continue;
+                    }
+                    detach(probe, held);
+                    openSet.remove(held);
+                    leaves.remove(held);
+                    pool[held].f      = tentativeF;
+                    pool[held].g      = tentativeG;
+                    pool[held].dir    = idx;
+                    pool[held].parent = node;
+                    pool[held].depth  = depth;
+                    std::fill_n(remembered.begin() + held * ndirs, ndirs, 0);
+                    pool[node].children++;
+                    queue(probe, held);
+                    continue;
+                }
+
+                // A cell already reached cheaper without being deeper leads nowhere its other visit doesn't
+                if(dominated(perCell ? next : next * ndirs + idx, tentativeG, depth)) {
+                    probe.skip();
+                    continue;
+                }
+
+                int child = allocateNode();
+                if(child < 0) {
+                    // Only the current path is held, the successor is too deep for the budget. Nothing queued is left
+                    // to be cheaper than the node expanded though, so reaching the goal at its f still ends the search.
+                    if(leaves.empty()) {
+                        if(next == goal && tentativeF == current.f) {
+                            found.push_back(next);
+                            finish(node, tentativeG);
+                            return true;
+                        }
+                        hit = true;
+                        continue;
+                    }
+                    // The successor is no better than the worst leaf, remember it instead of swapping them
+                    const Worst worst = leaves.top();
+                    if(!(Worst{tentativeF, tentativeG, -1} > worst)) {
+                        pool[node].forgotten           = std::min(pool[node].forgotten, tentativeF);
+                        remembered[node * ndirs + idx] = tentativeF;
+                        hit                            = true;
+                        continue;
+                    }
+                    evict(probe, worst.node);
+                    child = allocateNode();
+                    hit   = true;
+                }
+                pool[child] = {tentativeF, tentativeG, INFINITE, next, idx, node, 0, depth};
+                insert(child);
+                pool[node].children++;
+                queue(probe, child);
+            }
+
+            expanding = -1;
+            if(pool[node].children == 0) {
+                pool[node].f = pool[node].forgotten;
+                queue(probe, node);
+            }
+        }
+        return false;
+    }
+};
+
+}    // namespace cam::pathfinder
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <pathfinder/BucketQueue.hpp>
+#include <pathfinder/IndexedHeap.hpp>
+
+#include <cstdint>
+
+namespace cam::pathfinder {
+
+/// @brief Open set of a search, choosing the queue from the priorities it receives.
+///
+/// Every search starts with a BucketQueue, the fastest choice for unit and small integer costs. As soon as a pushed
+/// priority doesn't fit in it (not integral, or too far from the others) the queued items are moved to an IndexedHeap,
+/// which is used until the next reset.
+/// @tparam Item Queued value, ordered with operator> and with a public member `f` holding its priority.
+template<typename Item>
+class OpenSet {
+    BucketQueue<Item> buckets;
+    IndexedHeap<Item> heap;
+    size_t            keys     = 0;
+    bool              bucketed = true;
+
+    void
+    fallback() {
+        heap.reset(keys);
+        buckets.drain([this](uint32_t key, const Item &item) { heap.push(key, item); });
+        bucketed = false;
+    }
+
+public:
+    /// @brief Empties the set, going back to the bucket queue, and makes room for the given number of keys.
+    void
+    reset(size_t keys) {
+        this->keys = keys;
+        bucketed   = true;
+        buckets.reset(keys);
+    }
+
+    /// @brief True while the bucket queue is in use.
+    inline bool
+    isBucketed() const {
+        return bucketed;
+    }
+
+    inline bool
+    empty() const {
+        return bucketed ? buckets.empty() : heap.empty();
+    }
+
+    inline size_t
+    size() const {
+        return bucketed ? buckets.size() : heap.size();
+    }
+
+    /// @brief Memory held by both queues, in bytes.
+    inline size_t
+    bytes() const {
+        return buckets.bytes() + heap.bytes();
+    }
+
+    inline bool
+    contains(uint32_t key) const {
+        return bucketed ? buckets.contains(key) : heap.contains(key);
+    }
+
+    /// @brief Queues an item, or lowers the one already queued for the same key.
+    /// @return True if the set changed, false if the key was already queued with an item not greater than this one.
+    inline bool
+    push(uint32_t key, const Item &item) {
+        if(bucketed) {
+            if(buckets.fits(item)) {
+                return buckets.push(key, item);
+            }
+            fallback();
+        }
+        return heap.push(key, item);
+    }
+
+    inline const Item &
+    top() const {
+        return bucketed ? buckets.top() : heap.top();
+    }
+
+    inline Item
+    pop() {
+        return bucketed ? buckets.pop() : heap.pop();
+    }
+};
+
+}    // namespace cam::pathfinder
@@ -0,0 +1,107 @@
+#include "ParallelPathFinder.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace cam::pathfinder {
+
+ParallelPathFinder::ParallelPathFinder(std::shared_ptr<const Grid> map, size_t threads) : map(std::move(map)) {
+    components.build(*this->map);
+    if(threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    solvers.resize(threads);
+    for(size_t idx = 0; idx < threads; idx++) {
+        workers.emplace_back(&ParallelPathFinder::work, this, idx);
+    }
+}
+
+ParallelPathFinder::~ParallelPathFinder() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for(auto &worker : workers) {
+        worker.join();
+    }
+}
+
+void
+ParallelPathFinder::work(size_t index) {
+    QuerySolver &solver = solvers[index];
+    uint64_t     seen   = 0;
+    Strategy     current;
+    while(true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || batch != seen; });
+            if(stopping) {
+                return;
+            }
+            seen    = batch;
+            current = strategy;
+        }
+
+        const size_t total = queries->size();
+        for(size_t first = next.fetch_add(chunk); first < total; first = next.fetch_add(chunk)) {
+            const size_t last = std::min(first + chunk, total);
+            for(size_t idx = first; idx < last; idx++) {
+                const auto &[from, to] = (*queries)[idx];
+                if(map->inside(from.getX(), from.getY()) && map->inside(to.getX(), to.getY()) &&
+                   !components.connectedShared(map->index(from.getX(), from.getY()), map->index(to.getX(), to.getY()))) {
+                    QueryResult &result = (*results)[idx];
+                    result.path.clear();
+                    result.cost  = std::numeric_limits<double>::max();
+                    result.bound = std::numeric_limits<double>::infinity();
+                    continue;
+                }
+                solver.solve(*map, current, (*queries)[idx], (*results)[idx]);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if(--running == 0) {
+            finished.notify_one();
+        }
+    }
+}
+
+void
+ParallelPathFinder::setStrategy(Strategy strategy) {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->strategy = strategy;
+}
+
+size_t
+ParallelPathFinder::threadCount() const {
+    return workers.size();
+}
+
+void
+ParallelPathFinder::solveBatch(const std::vector<Query> &queries, std::vector<QueryResult> &results) {
+    results.resize(queries.size());
+    if(queries.empty()) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    this->queries = &queries;
+    this->results = &results;
+    // Small chunks keep the threads balanced, big enough to not contend on the shared counter
+    chunk = std::max<size_t>(1, queries.size() / (workers.size() * 16));
+    next.store(0);
+    running = workers.size();
+    batch++;
+    wake.notify_all();
+    finished.wait(lock, [&] { return running == 0; });
+}
+
+std::vector<QueryResult>
+ParallelPathFinder::solveBatch(const std::vector<Query> &queries) {
+    std::vector<QueryResult> results;
+    solveBatch(queries, results);
+    return results;
+}
+
+}    // namespace cam::pathfinder
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <pathfinder/ConnectedComponents.hpp>
+#include <pathfinder/Grid.hpp>
+#include <pathfinder/QuerySolver.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cam::pathfinder {
+
+/// @brief Solves batches of independent path queries on all cores.
+///
+/// The map is shared read-only by every worker thread, and each worker owns a QuerySolver with its own search buffers,
+/// so nothing is locked while searching. Workers take chunks of queries from a shared counter until the batch is
+/// exhausted, which balances the load when some queries are much more expensive than others. The regions of the map are
+/// labeled once with it, so queries between disconnected regions are answered without dispatching a search.
+class ParallelPathFinder {
+    std::shared_ptr<const Grid> map;
+    ConnectedComponents<>       components;
+    Strategy                    strategy = Strategy::A_STAR;
+    std::vector<std::thread>    workers;
+    std::vector<QuerySolver>    solvers;
+
+    std::mutex              mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    uint64_t                batch    = 0;
+    size_t                  running  = 0;
+    bool                    stopping = false;
+
+    const std::vector<Query> *queries = nullptr;
+    std::vector<QueryResult> *results = nullptr;
+    std::atomic<size_t>       next{0};
+    size_t                    chunk = 1;
+
+    void work(size_t index);
+
+public:
+    /// @brief Starts the worker threads.
+    /// @param map Map shared by every query.
+    /// @param threads Number of worker threads, all the hardware threads by default.
+    explicit ParallelPathFinder(std::shared_ptr<const Grid> map, size_t threads = 0);
+    ~ParallelPathFinder();
+
+    ParallelPathFinder(const ParallelPathFinder &)            = delete;
+    ParallelPathFinder &operator=(const ParallelPathFinder &) = delete;
+
+    void   setStrategy(Strategy strategy);
+    size_t threadCount() const;
+
+    /// @brief Solves every query, one optimal path each, blocking until all of them are done. Batches must be submitted
+    /// from one thread at a time.
+    /// @param results Output, resized to the number of queries. The paths already stored in it are reused.
+    void                     solveBatch(const std::vector<Query> &queries, std::vector<QueryResult> &results);
+    std::vector<QueryResult> solveBatch(const std::vector<Query> &queries);
+};
+
+}    // namespace cam::pathfinder
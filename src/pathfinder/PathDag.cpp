@@ -0,0 +1,109 @@
+#include "PathDag.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace cam::pathfinder {
+
+void
+PathDag::reset(size_t cells, uint32_t goal) {
+    nodes.clear();
+    preds.clear();
+    mask.assign(cells, 0);
+    total = 0;
+    add(goal);
+}
+
+uint32_t
+PathDag::add(uint32_t cell) {
+    nodes.push_back({cell, 0, 0});
+    mask[cell] = 1;
+    return nodes.size() - 1;
+}
+
+void
+PathDag::open(uint32_t node) {
+    nodes[node].first = preds.size();
+    nodes[node].size  = 0;
+    opened            = node;
+}
+
+void
+PathDag::link(uint32_t pred) {
+    preds.push_back(pred);
+    nodes[opened].size++;
+}
+
+void
+PathDag::finish() {
+    // Post-order walk from the goal, so every node is counted after all its predecessors
+    constexpr uint64_t                         SATURATED = std::numeric_limits<uint64_t>::max();
+    std::vector<uint64_t>                      counts(nodes.size(), 0);
+    std::vector<uint8_t>                       done(nodes.size(), 0);
+    std::vector<std::pair<uint32_t, uint32_t>> stack = {{0, 0}};
+    while(!stack.empty()) {
+        auto &[node, cursor] = stack.back();
+        if(cursor < nodes[node].size) {
+            const uint32_t pred = preds[nodes[node].first + cursor++];
+            if(!done[pred]) {
+                stack.push_back({pred, 0});
+            }
+            continue;
+        }
+
+        uint64_t count = nodes[node].size == 0 ? 1 : 0;
+        for(uint32_t idx = 0; idx < nodes[node].size; idx++) {
+            const uint64_t paths = counts[preds[nodes[node].first + idx]];
+            count                = paths > SATURATED - count ? SATURATED : count + paths;
+        }
+        counts[node] = count;
+        done[node]   = 1;
+        stack.pop_back();
+    }
+    total = counts[0];
+}
+
+PathDag::iterator::iterator(const PathDag *dag) : dag(dag) {
+    stack.push_back({0, 0});
+    descend();
+    build();
+}
+
+/// @brief Walks the current predecessor of every node from the top of the stack down to the start.
+void
+PathDag::iterator::descend() {
+    while(true) {
+        const auto &[node, cursor] = stack.back();
+        const Node &current        = dag->nodes[node];
+        if(current.size == 0) {
+            return;
+        }
+        stack.push_back({dag->preds[current.first + cursor], 0});
+    }
+}
+
+void
+PathDag::iterator::build() {
+    path.clear();
+    for(auto it = stack.rbegin(); it != stack.rend(); ++it) {
+        path.push_back(dag->nodes[it->first].cell);
+    }
+}
+
+PathDag::iterator &
+PathDag::iterator::operator++() {
+    stack.pop_back();
+    while(!stack.empty()) {
+        auto &[node, cursor] = stack.back();
+        if(++cursor < dag->nodes[node].size) {
+            descend();
+            build();
+            return *this;
+        }
+        stack.pop_back();
+    }
+    path.clear();
+    return *this;
+}
+
+}    // namespace cam::pathfinder
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <pathfinder/Grid.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace cam::pathfinder {
+
+/// @brief Every optimal path between two cells, stored as a directed acyclic graph of predecessors.
+///
+/// Each node is a search state (a cell, reached from a given direction) lying on some optimal path, linked to the
+/// states it can be optimally reached from. Node 0 is the goal and the nodes without predecessors are the start, so
+/// each path from the start to the goal through the links is an optimal path. The graph takes memory proportional to
+/// the cells involved, while the number of paths can grow exponentially with the size of the map: paths are counted
+/// without enumerating them and enumerated lazily, one at a time.
+class PathDag {
+    struct Node {
+        uint32_t cell;
+        uint32_t first;    // index of the first predecessor in preds
+        uint32_t size;     // number of predecessors
+    };
+
+    std::vector<Node>     nodes;
+    std::vector<uint32_t> preds;
+    std::vector<uint8_t>  mask;
+    uint32_t              opened = 0;
+    uint64_t              total  = 0;
+
+public:
+    using Path = std::vector<uint32_t>;
+
+    /// @brief Forward iterator over the paths, as lists of cell ids from start to goal. The first path follows the
+    /// first predecessor of every node.
+    class iterator {
+        const PathDag                             *dag = nullptr;
+        std::vector<std::pair<uint32_t, uint32_t>> stack;    // node and index of the predecessor being walked
+        Path                                       path;
+
+        void descend();
+        void build();
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Path;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const Path *;
+        using reference         = const Path &;
+
+        iterator() = default;
+        explicit iterator(const PathDag *dag);
+
+        inline reference
+        operator*() const {
+            return path;
+        }
+        inline pointer
+        operator->() const {
+            return &path;
+        }
+        iterator &operator++();
+        iterator
+        operator++(int) {
+            iterator ret = *this;
+            ++(*this);
+            return ret;
+        }
+        inline bool
+        operator==(const iterator &other) const {
+            return stack == other.stack;
+        }
+        inline bool
+        operator!=(const iterator &other) const {
+            return !(*this == other);
+        }
+    };
+
+    /// @brief Empties the graph, adding the goal node.
+    /// @param cells Number of cell ids of the map, for the on path mask.
+    /// @param goal Cell id of the goal.
+    void reset(size_t cells, uint32_t goal);
+
+    /// @brief Adds a node for a cell.
+    /// @return Index of the node.
+    uint32_t add(uint32_t cell);
+
+    /// @brief Starts the predecessor list of a node, every link() until the next open() is added to it. Each node must
+    /// be opened once.
+    void open(uint32_t node);
+
+    /// @brief Adds a predecessor to the last opened node.
+    void link(uint32_t pred);
+
+    /// @brief Counts the paths once every node has its predecessors, saturating at the maximum uint64_t.
+    void finish();
+
+    inline bool
+    empty() const {
+        return total == 0;
+    }
+
+    /// @brief Number of optimal paths, saturated at the maximum uint64_t.
+    inline uint64_t
+    count() const {
+        return total;
+    }
+
+    /// @brief Number of search states on some optimal path.
+    inline size_t
+    size() const {
+        return nodes.size();
+    }
+
+    /// @brief Memory held by the graph, in bytes.
+    inline size_t
+    bytes() const {
+        return nodes.capacity() * sizeof(Node) + preds.capacity() * sizeof(uint32_t) + mask.capacity();
+    }
+
+    /// @brief Checks if a cell id lies on some optimal path.
+    inline bool
+    onPath(uint32_t cell) const {
+        return cell < mask.size() && mask[cell] != 0;
+    }
+
+    iterator
+    begin() const {
+        return empty() ? iterator() : iterator(this);
+    }
+    iterator
+    end() const {
+        return iterator();
+    }
+};
+
+/// @brief Read only range over the paths of a shared PathDag, converting the cell ids into map positions. The range and
+/// its iterators keep the graph alive, so they stay valid after the path finder that made them searches again.
+/// @tparam Position Type of the positions, built from the x and y of every cell.
+template<typename Position>
+class OptimalPaths {
+    std::shared_ptr<const PathDag> dag;
+    int                            stride = 1;
+
+public:
+    class iterator {
+        std::shared_ptr<const PathDag> dag;
+        int                            stride = 1;
+        PathDag::iterator              it;
+        std::vector<Position>          current;
+
+        void
+        convert() {
+            current.clear();
+            if(it != PathDag::iterator()) {
+                for(uint32_t cell : *it) {
+                    current.emplace_back((int)(cell % stride) - Grid::BORDER, (int)(cell / stride) - Grid::BORDER);
+                }
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = std::vector<Position>;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const value_type *;
+        using reference         = const value_type &;
+
+        iterator() = default;
+        iterator(std::shared_ptr<const PathDag> dag, int stride) : dag(std::move(dag)), stride(stride), it(this->dag->begin()) {
+            convert();
+        }
+
+        inline reference
+        operator*() const {
+            return current;
+        }
+        inline pointer
+        operator->() const {
+            return &current;
+        }
+        iterator &
+        operator++() {
+            ++it;
+            convert();
+            return *this;
+        }
+        inline bool
+        operator==(const iterator &other) const {
+            return it == other.it;
+        }
+        inline bool
+        operator!=(const iterator &other) const {
+            return it != other.it;
+        }
+    };
+
+    OptimalPaths() = default;
+
+    /// @param dag Paths to walk, nullptr for none.
+    /// @param stride Cell id offset between two consecutive rows of the map.
+    OptimalPaths(std::shared_ptr<const PathDag> dag, int stride) : dag(std::move(dag)), stride(stride) {}
+
+    iterator
+    begin() const {
+        return dag ? iterator(dag, stride) : iterator();
+    }
+    iterator
+    end() const {
+        return iterator();
+    }
+
+    inline bool
+    empty() const {
+        return !dag || dag->empty();
+    }
+
+    /// @brief Number of paths, computed without enumerating them.
+    inline uint64_t
+    size() const {
+        return dag ? dag->count() : 0;
+    }
+
+    /// @brief First path, empty if there is none.
+    std::vector<Position>
+    front() const {
+        return empty() ? std::vector<Position>() : *begin();
+    }
+
+    /// @brief Checks if a position lies on some optimal path.
+    inline bool
+    onPath(int x, int y) const {
+        return dag && dag->onPath((y + Grid::BORDER) * stride + x + Grid::BORDER);
+    }
+
+    /// @brief Graph backing the paths, nullptr if there are none.
+    inline const std::shared_ptr<const PathDag> &
+    graph() const {
+        return dag;
+    }
+};
+
+}    // namespace cam::pathfinder
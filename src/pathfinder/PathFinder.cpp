@@ -1,4 +1,6 @@
 #include "PathFinder.hpp"
+#include "MapLoader.hpp"
+#include "Policies.hpp"
 
 #include <algorithm>
 #include <queue>
@@ -6,30 +8,25 @@
 #include <map>
 #include <cmath>
 #include <iostream>
-#include <sstream>
 #include <iomanip>
+#include <typeinfo>
 
 using namespace cam::math;
 
 namespace cam::pathfinder {
 
-std::vector<std::vector<Type>>
+/// @brief Builds the map from its rows, with the characters of MapLoader::cellType(): '.' is an empty cell, '1' to '9'
+/// an empty cell with that terrain weight, 'S' the start, 'E' the end and '#' a wall. Any other character is a wall
+/// too, so typos never open a way through, and rows shorter than the first one are padded with walls.
+Grid
 PathFinder::parse(const std::vector<std::string> &data) const {
-    const size_t                   HEIGHT = data.size();
-    const size_t                   WIDTH  = data[0].size();
-    std::vector<std::vector<Type>> ret(HEIGHT, std::vector<Type>(WIDTH, EMPTY));
-    for(size_t y = 0; y < HEIGHT; y++) {
-        for(size_t x = 0; x < WIDTH; x++) {
-            if(data[y][x] == '.') {
-                ret[y][x] = EMPTY;
-            } else if(data[y][x] == 'S') {
-                ret[y][x] = START;
-            } else if(data[y][x] == 'E') {
-                ret[y][x] = END;
-            } else if(data[y][x] == '#') {
-                ret[y][x] = BLOCK;
-            }
-        }
+    const int HEIGHT = data.size();
+    const int WIDTH  = data[0].size();
+    Grid      ret(WIDTH, HEIGHT, BLOCK);
+    uint32_t  start = 0;
+    uint32_t  end   = 0;
+    for(int y = 0; y < HEIGHT; y++) {
+        MapLoader::parseRow(ret, y, data[y].data(), data[y].size(), start, end);
     }
 
     return ret;
@@ -37,13 +34,13 @@ PathFinder::parse(const std::vector<std::string> &data) const {
 
 bool
 PathFinder::inside(const Vector2 &pos) const {
-    return (pos.getY() >= 0 && pos.getX() >= 0 && pos.getY() < map.size() && pos.getX() < map[pos.getY()].size());
+    return (pos.getY() >= 0 && pos.getX() >= 0 && pos.getY() < map.getHeight() && pos.getX() < map.getWidth());
 }
 
 bool
 PathFinder::canMove(const Vector2 &pos, const Vector2 &target) const {
     if(inside(target)) {
-        return (map[target.getY()][target.getX()] != BLOCK);
+        return !map.isBlocked(map.index((int)target.getX(), (int)target.getY()));
     }
     return false;
 }
@@ -64,165 +61,464 @@ PathFinder::computeHeuristic(const Vector2 &pos, const Vector2 &target) const {
 }
 
 /// @brief This methods returns the first node status. The node is composed by the cell position, the score at this position, the direction
-/// index inside the valid direction array and the path to the current cell position (this last one included).
+/// index inside the valid direction array and the arena slot of its parent node (-1 as the start node has no parent).
 /// @param start This param indicates the position of the start cell.
 /// @return A node object representing the initial search status.
 Node
 PathFinder::onStart(const Vector2 &start) const {
-    return {start, 0, 0, {start}};
+    return {start, 0, 0, -1};
+}
+
+PathFinder::HookNeighborhood::HookNeighborhood(const PathFinder &finder) : finder(&finder), dirs(finder.getValidDirections()) {
+    for(const auto &dir : dirs) {
+        offsets.push_back(finder.map.offset(dir.getX(), dir.getY()));
+    }
+}
+
+int
+PathFinder::HookNeighborhood::size() const {
+    return dirs.size();
+}
+
+int
+PathFinder::HookNeighborhood::offset(const Grid &map, int dir) const {
+    return offsets[dir];
+}
+
+bool
+PathFinder::HookNeighborhood::canMove(const Grid &map, uint32_t from, uint32_t to, int dir) const {
+    auto pos = map.position(from);
+    return to < map.size() && finder->canMove(Vector2(pos.getX(), pos.getY()), Vector2(pos.getX(), pos.getY()) + dirs[dir]);
+}
+
+PathFinder::HookCost::Score
+PathFinder::HookCost::step(const Grid &map, const SearchNode<Score> &from, uint32_t to, int dir) const {
+    auto pos    = map.position(from.cell);
+    auto target = map.position(to);
+    return finder->computeCost({Vector2(pos.getX(), pos.getY()), from.g, from.dir, from.parent}, Vector2(target.getX(), target.getY()));
+}
+
+/// @brief Jump Point Search assumes computeCost() charges the weight of the cell entered, as the default one does, so
+/// it runs through the hooks as long as every weight is one.
+bool
+PathFinder::HookCost::uniform(const Grid &map) const {
+    return !map.isWeighted();
+}
+
+/// @brief computeCost() receives the direction the current cell was reached from, so overrides may charge for turns.
+bool
+PathFinder::HookCost::directional() const {
+    return true;
+}
+
+/// @brief Checks if the hooks are the ones of PathFinder itself, so the search can use the compile-time policies.
+bool
+PathFinder::isPlain() const {
+    return typeid(*this) == typeid(PathFinder);
+}
+
+/// @brief Binds the hook policies to this object and the current map.
+PathFinder::HookSolver &
+PathFinder::hooks() const {
+    hookSolver.setPolicies(HookNeighborhood(*this), HookCost{this});
+    return hookSolver;
+}
+
+/// @brief Points both solvers to the statistics right before searching, so copies of the finder never share them.
+void
+PathFinder::instrument() const {
+    const bool           enabled  = statsEnabled || trace;
+    SearchStats         *counters = enabled ? &searchStats : nullptr;
+    const TraceCallback *callback = enabled && trace ? &trace : nullptr;
+    solver.instrument(counters, callback);
+    hookSolver.instrument(counters, callback);
+}
+
+/// @brief Checks if two free cells lie in regions no path joins. Only the moves of a plain PathFinder are known, so
+/// subclasses always search.
+bool
+PathFinder::separated(uint32_t start, uint32_t end) const {
+    return isPlain() && !components.connected(start, end);
+}
+
+/// @brief Relabels the regions after a search found no path while they were stale, as the search already cost as much.
+void
+PathFinder::searchFailed() const {
+    if(isPlain() && components.isStale()) {
+        components.build(map);
+    }
 }
 
-struct Position {
-    int x;
-    int y;
-    int dir;
+/// @brief Suboptimality bound of the path found by the last searchPath().
+double
+PathFinder::lastBound() const {
+    return isPlain() ? solver.bound() : hookSolver.bound();
+}
 
-    // Operador de comparación estricta
-    bool
-    operator<(const Position &other) const {
-        if(x != other.x) {
-            return x < other.x;
+/// @brief Labels the regions of a new map, and makes the next anytime search start over.
+void
+PathFinder::mapChanged() {
+    if(isPlain()) {
+        components.build(map);
+    } else {
+        components.clear();
+    }
+    solver.restart();
+    hookSolver.restart();
+}
+
+/// @brief Runs the A* core, keeping the graph of equivalent paths.
+/// @param bound Known upper bound of the optimal cost.
+/// @return The optimal cost, or the maximum double value if there is no path.
+double
+PathFinder::searchEquivalents(double bound) const {
+    optimalPaths.reset();
+    pendingAlternatives = false;
+    if(startCell == 0 || endCell == 0 || separated(startCell, endCell)) {
+        return std::numeric_limits<double>::max();
+    }
+
+    instrument();
+    // Subclasses may override any hook, so they search through the hook policies. A plain PathFinder runs the integer
+    // policies, which have no virtual calls nor floating point work in the search loop.
+    if(isPlain()) {
+        const int limit = bound < SearchCore<int>::INFINITE ? (int)bound : SearchCore<int>::INFINITE;
+        int       cost;
+        if(const PathDag *dag = solver.searchEquivalents(map, startCell, endCell, cost, limit); dag != nullptr) {
+            optimalPaths = std::make_shared<const PathDag>(*dag);
+            return cost;
         }
-        if(y != other.y) {
-            return y < other.y;
+    } else {
+        auto           pos   = map.position(startCell);
+        Node           first = onStart(Vector2(pos.getX(), pos.getY()));
+        const uint32_t start = map.index(first.pos.getX(), first.pos.getY());
+        double         cost;
+        if(const PathDag *dag = hooks().searchEquivalents(map, start, endCell, cost, bound, first.g, first.dir); dag != nullptr) {
+            optimalPaths = std::make_shared<const PathDag>(*dag);
+            return cost;
         }
-        return dir < other.dir;
     }
-};
+    searchFailed();
+    return std::numeric_limits<double>::max();
+}
+
+/// @brief Searches a single optimal path between two cells with the current strategy, reusing the buffers of the
+/// previous searches. Jump Point Search falls back to A* when the valid directions aren't the four straight moves.
+/// @param start Cell id where the path starts.
+/// @param end Cell id where the path ends.
+/// @param cost Output with the cost of the path.
+/// @return The cell ids of the path, or nullptr if there is none. It is valid until the next search.
+const std::vector<uint32_t> *
+PathFinder::searchPath(uint32_t start, uint32_t end, double &cost) {
+    cost = std::numeric_limits<double>::max();
+    if(separated(start, end)) {
+        return nullptr;
+    }
+
+    instrument();
+    const std::vector<uint32_t> *path;
+    if(isPlain()) {
+        int unitCost;
+        path = solver.search(map, strategy, start, end, unitCost);
+        cost = path != nullptr ? unitCost : cost;
+    } else {
+        path = hooks().search(map, strategy, start, end, cost);
+    }
+    if(path == nullptr) {
+        searchFailed();
+    }
+    return path;
+}
 
 std::vector<math::Vector2>
 PathFinder::solve_a_star() {
-    math::Vector2 start;
-    math::Vector2 end;
-    auto          dirs = getValidDirections();
-
-    const int HEIGHT = map.size();
-    const int WIDTH  = map[0].size();
-    const int NDIRS  = dirs.size();
-
-    for(size_t y = 0; y < map.size(); ++y) {
-        for(size_t x = 0; x < map[y].size(); ++x) {
-            if(map[y][x] == START) {
-                start.set(x, y);
-            } else if(map[y][x] == END) {
-                end.set(x, y);
-            }
-        }
+    minCost = searchEquivalents(std::numeric_limits<double>::max());
+    return alternatives().front();
+}
+
+/// @brief Searches a single optimal path with the current strategy. Equivalent paths are only searched if
+/// alternatives() is called, using the cost found here as bound.
+std::vector<math::Vector2>
+PathFinder::solve_single_path() {
+    optimalPaths.reset();
+    pendingAlternatives = false;
+    minCost             = std::numeric_limits<double>::max();
+    costBound           = std::numeric_limits<double>::infinity();
+    if(startCell == 0 || endCell == 0) {
+        return {};
     }
 
-    equivalentPaths.clear();
+    const std::vector<uint32_t> *cells = searchPath(startCell, endCell, minCost);
+    if(cells == nullptr) {
+        return {};
+    }
+    costBound = lastBound();
 
-    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> openSet;
-    std::vector<int>                                                 visited(HEIGHT * WIDTH * NDIRS, std::numeric_limits<int>::max());
+    std::vector<Vector2> path;
+    path.reserve(cells->size());
+    for(uint32_t cell : *cells) {
+        auto pos = map.position(cell);
+        path.emplace_back(pos.getX(), pos.getY());
+    }
+    pendingAlternatives = true;
+    return path;
+}
 
-    minCost = std::numeric_limits<double>::max();
-    openSet.push(onStart(start));
-    while(!openSet.empty()) {
-        Node current = openSet.top();
-        openSet.pop();
+void
+PathFinder::dump() const {
+    if(pendingAlternatives) {
+        searchEquivalents(minCost);
+    }
 
-        if(current.g > minCost) {
-            continue;
+    const int      HEIGHT = map.getHeight();
+    const int      WIDTH  = map.getWidth();
+    const size_t   LINE   = WIDTH + 1;
+    const PathDag *paths  = optimalPaths.get();
+
+    // Character of every weight and type, off and on an optimal path, so the rows are written without branching on the
+    // contents of the cells, which follow no pattern the CPU could predict
+    char glyphs[2][Grid::MAX_WEIGHT][4];
+    for(int weight = 1; weight <= Grid::MAX_WEIGHT; weight++) {
+        for(int type = EMPTY; type <= BLOCK; type++) {
+            glyphs[0][weight - 1][type] = type == BLOCK ? '#' : weight > 1 ? (char)('0' + std::min(weight, 9)) : '.';
+            glyphs[1][weight - 1][type] = type == BLOCK ? '#' : 'x';
         }
+    }
 
-        if(current.pos == end) {
-            if(current.g < minCost) {
-                minCost = current.g;
-                equivalentPaths.clear();
-            }
-
-            if(current.g == minCost) {
-                equivalentPaths.push_back(current.path);
-            }
-            continue;
+    // Every row is written in place into a single buffer, already holding the line endings, and printed at once
+    std::string out(1 + LINE * HEIGHT, '\n');
+    for(int y = 0; y < HEIGHT; y++) {
+        char    *line = &out[1 + y * LINE];
+        uint32_t cell = map.index(0, y);
+        for(int x = 0; x < WIDTH; x++, cell++) {
+            const bool onPath = paths != nullptr && paths->onPath(cell);
+            line[x]           = glyphs[onPath][map.weight(cell) - 1][map.at(cell)];
         }
+    }
+    for(const auto &pos : solution) {
+        out[1 + (size_t)pos.getY() * LINE + (size_t)pos.getX()] = '+';
+    }
 
-        int offset = (WIDTH * (int)current.pos.getY() + (int)current.pos.getX()) * NDIRS + current.dir;
-        if(visited[offset] <= current.g) {
-            continue;
-        }
-        visited[offset] = current.g;
+    std::cout.write(out.data(), out.size());
+}
 
-        for(size_t idx = 0; idx < dirs.size(); idx++) {
-            const auto &dir = dirs[idx];
+const Grid &
+PathFinder::getMap() const {
+    return map;
+}
 
-            math::Vector2 neighbor = current.pos + dir;
+void
+PathFinder::set(const std::vector<std::string> &data) {
+    map       = parse(data);
+    startCell = map.find(START);
+    endCell   = map.find(END);
+    mapChanged();
+}
 
-            if(!canMove(current.pos, neighbor)) {
-                continue;
-            }
-            if(std::find(current.path.begin(), current.path.end(), neighbor) != current.path.end()) {
-                continue;
-            }
+/// @brief Reads the map straight from a file, without building its rows, see MapLoader::parse(). parse() isn't called,
+/// so the file always uses the default characters.
+/// @return False if the file can't be read or holds no map, leaving the current map untouched.
+bool
+PathFinder::load(const std::string &path) {
+    LoadedMap loaded;
+    if(!MapLoader::load(path, loaded)) {
+        return false;
+    }
+    map       = std::move(loaded.grid);
+    startCell = loaded.start;
+    endCell   = loaded.end;
+    mapChanged();
+    return true;
+}
 
-            double tentativeG = computeCost(current, neighbor);
-            if(tentativeG > minCost) {
-                continue;
-            }
+/// @brief Changes a cell of the map, keeping its weight. Setting a START or END cell moves the start or the end there,
+/// the previous one becoming EMPTY. The regions used to reject unreachable queries are updated, and the last solution
+/// is discarded.
+void
+PathFinder::updateCell(int x, int y, Type type) {
+    if(!map.inside(x, y)) {
+        return;
+    }
 
-            auto copy = current.path;
-            copy.push_back(neighbor);
-            openSet.push({neighbor, tentativeG, (int)idx, copy});
+    const uint32_t cell       = map.index(x, y);
+    const bool     wasBlocked = map.isBlocked(cell);
+    if(type == START || type == END) {
+        uint32_t &endpoint = type == START ? startCell : endCell;
+        if(endpoint != 0 && endpoint != cell) {
+            map.set(endpoint, EMPTY);
         }
+        endpoint = cell;
+    }
+    if(cell == startCell && type != START) {
+        startCell = 0;
     }
+    if(cell == endCell && type != END) {
+        endCell = 0;
+    }
+    map.set(cell, type);
+    if(wasBlocked != map.isBlocked(cell) && isPlain()) {
+        components.update(map, cell);
+    }
+    solver.restart();
+    hookSolver.restart();
+
+    solution.clear();
+    optimalPaths.reset();
+    pendingAlternatives = false;
+    minCost             = std::numeric_limits<double>::max();
+    costBound           = std::numeric_limits<double>::infinity();
+}
 
-    return !equivalentPaths.empty() ? equivalentPaths.front() : std::vector<math::Vector2>();
+void
+PathFinder::setStrategy(Strategy strategy) {
+    this->strategy = strategy;
 }
 
+/// @brief Sets the suboptimality bound of the WEIGHTED_A_STAR strategy, at least 1.
 void
-PathFinder::dump() const {
-    const size_t HEIGHT = map.size();
-    const size_t WIDTH  = map[0].size();
-
-    std::stringstream ss;
-    ss << std::endl;
-    for(size_t y = 0; y < HEIGHT; y++) {
-        for(size_t x = 0; x < WIDTH; x++) {
-            if(map[y][x] == BLOCK) {
-                ss << "#";
-            } else if(std::find(solution.begin(), solution.end(), Vector2(x, y)) != solution.end()) {
-                ss << "+";
-            } else {
-                bool found = false;
-                for(const auto &l : equivalentPaths) {
-                    if(std::find(l.begin(), l.end(), Vector2(x, y)) != l.end()) {
-                        found = true;
-                        break;
-                    }
-                }
-                ss << (found ? "x" : ".");
-            }
-        }
-        ss << std::endl;
-    }
+PathFinder::setEpsilon(double epsilon) {
+    solver.setEpsilon(epsilon);
+    hookSolver.setEpsilon(epsilon);
+}
 
-    std::cout << ss.str();
+/// @brief Sets the memory every search of the ITERATIVE_DEEPENING and MEMORY_BOUNDED strategies may hold, in bytes. The
+/// searches reaching it are counted in SearchStats::budgetHits. Equivalent paths are still searched with A* if
+/// requested.
+void
+PathFinder::setMemoryBudget(size_t bytes) {
+    solver.setMemoryBudget(bytes);
+    hookSolver.setMemoryBudget(bytes);
 }
 
+/// @brief Limits every search of the ANYTIME strategy to a wall time and a number of expansions, zero meaning no limit.
+/// solve() then returns the best path found in time, see bound(), and calling it again on the same map and endpoints
+/// keeps improving that path until it is optimal.
 void
-PathFinder::set(const std::vector<std::string> &data) {
-    map = parse(data);
+PathFinder::setAnytimeLimits(std::chrono::nanoseconds deadline, uint64_t expansions) {
+    solver.setAnytimeLimits(deadline, expansions);
+    hookSolver.setAnytimeLimits(deadline, expansions);
+}
+
+/// @brief Collects statistics of the searches, see stats(). Disabled searches run without any instrumentation.
+void
+PathFinder::setStatsEnabled(bool enabled) {
+    statsEnabled = enabled;
+}
+
+/// @brief Reports every expansion of the next searches, collecting statistics too. An empty callback removes it. An
+/// ExpansionHeatmap callback prints the order of the expansions over the map.
+void
+PathFinder::setTrace(TraceCallback trace) {
+    this->trace = std::move(trace);
+}
+
+/// @brief Statistics of the last solve() or solveBatch(), including the equivalent paths searched afterwards by
+/// alternatives() or dump().
+const SearchStats &
+PathFinder::stats() const {
+    return searchStats;
 }
 
 std::vector<math::Vector2>
 PathFinder::solve() {
-    solution = solve_a_star();
+    searchStats.reset();
+    switch(strategy) {
+        case Strategy::A_STAR:
+            solution  = solve_a_star();
+            costBound = solution.empty() ? std::numeric_limits<double>::infinity() : 1.0;
+            break;
+        default:
+            solution = solve_single_path();
+            break;
+    }
     return solution;
 }
 
-std::vector<std::vector<math::Vector2>>
+/// @brief Every optimal path of the last solve, enumerated lazily from the graph of equivalent paths. Its size() counts
+/// them without enumerating.
+OptimalPaths<math::Vector2>
 PathFinder::alternatives() const {
-    return equivalentPaths;
+    if(pendingAlternatives) {
+        searchEquivalents(minCost);
+    }
+    return OptimalPaths<Vector2>(optimalPaths, map.getStride());
 }
+std::vector<QueryResult>
+PathFinder::solveBatch(const std::vector<Query> &queries) {
+    std::vector<QueryResult> results;
+    solveBatch(queries, results);
+    return results;
+}
+
+/// @brief Solves several queries on the current map with the current strategy. Only one optimal path is searched per
+/// query and the search buffers are shared by all of them. The results vector is resized to the number of queries and
+/// the paths already stored in it are overwritten, so reusing it between batches avoids reallocations too.
+void
+PathFinder::solveBatch(const std::vector<Query> &queries, std::vector<QueryResult> &results) {
+    results.resize(queries.size());
+    searchStats.reset();
+    if(isPlain()) {
+        instrument();
+        for(size_t idx = 0; idx < queries.size(); idx++) {
+            const auto &[from, to] = queries[idx];
+            if(map.inside(from.getX(), from.getY()) && map.inside(to.getX(), to.getY()) &&
+               separated(map.index(from.getX(), from.getY()), map.index(to.getX(), to.getY()))) {
+                results[idx].path.clear();
+                results[idx].cost  = std::numeric_limits<double>::max();
+                results[idx].bound = std::numeric_limits<double>::infinity();
+                continue;
+            }
+            solver.solve(map, strategy, queries[idx], results[idx]);
+            if(results[idx].path.empty()) {
+                searchFailed();
+            }
+        }
+        return;
+    }
+
+    for(size_t idx = 0; idx < queries.size(); idx++) {
+        const auto &[from, to] = queries[idx];
+        auto &result           = results[idx];
+
+        result.path.clear();
+        result.cost  = std::numeric_limits<double>::max();
+        result.bound = std::numeric_limits<double>::infinity();
+        if(!map.inside(from.getX(), from.getY()) || !map.inside(to.getX(), to.getY())) {
+            continue;
+        }
+
+        const uint32_t start = map.index(from.getX(), from.getY());
+        const uint32_t end   = map.index(to.getX(), to.getY());
+        if(map.isBlocked(start) || map.isBlocked(end)) {
+            continue;
+        }
+
+        if(const std::vector<uint32_t> *cells = searchPath(start, end, result.cost); cells != nullptr) {
+            result.bound = lastBound();
+            for(uint32_t cell : *cells) {
+                result.path.push_back(map.position(cell));
+            }
+        }
+    }
+}
+
 double
 PathFinder::cost() const {
     return minCost;
 }
 
+/// @brief Suboptimality bound of the last solve(): cost() is at most this many times the optimal cost. 1 for the exact
+/// strategies, epsilon for WEIGHTED_A_STAR, the bound proven so far for ANYTIME, and infinity if no path was found or a
+/// memory bounded search reached its budget.
+double
+PathFinder::bound() const {
+    return costBound;
+}
+
 double
 PathFinder::computeCost(const Node &current, const Vector2 &target) const {
     if(inside(current.pos) && inside(target)) {
-        return current.g + computeHeuristic(current.pos, target);
+        return current.g + computeHeuristic(current.pos, target) * map.weight(map.index((int)target.getX(), (int)target.getY()));
     }
     return std::numeric_limits<double>::max();
 }
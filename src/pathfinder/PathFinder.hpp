@@ -1,19 +1,31 @@
 #pragma once
 
 #include <math/Vector2.hpp>
+#include <pathfinder/ConnectedComponents.hpp>
+#include <pathfinder/Grid.hpp>
+#include <pathfinder/PathDag.hpp>
+#include <pathfinder/Policies.hpp>
+#include <pathfinder/QuerySolver.hpp>
+#include <pathfinder/SearchCore.hpp>
+#include <pathfinder/SearchStats.hpp>
 
+#include <chrono>
+#include <limits>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace cam::pathfinder {
 
-enum Type { EMPTY, START, END, BLOCK };
-
+/// @brief Search status of a single cell. Instead of carrying its own copy of the path, each node points to the arena
+/// slot (cell position and direction) of the node it was expanded from, so paths are only rebuilt once the goal is
+/// reached.
 struct Node {
-    math::Vector2              pos;
-    double                     g;
-    int                        dir;
-    std::vector<math::Vector2> path;
+    math::Vector2 pos;
+    double        g;
+    int           dir;
+    int           parent;
 
     bool
     operator>(const Node &other) const {
@@ -21,31 +33,97 @@ struct Node {
     }
 };
 
+/// @brief Path finder customizable through virtual hooks.
+///
+/// A thin adapter over the policy based search: a plain PathFinder searches with the compile-time unit cost policies,
+/// as BasicPathFinder does, while subclasses search through policies forwarding to the virtual hooks they override.
 class PathFinder {
+    /// @brief Neighborhood policy forwarding to getValidDirections() and canMove().
+    struct HookNeighborhood {
+        const PathFinder          *finder = nullptr;
+        std::vector<math::Vector2> dirs;
+        std::vector<int>           offsets;
+
+        HookNeighborhood() = default;
+        explicit HookNeighborhood(const PathFinder &finder);
+
+        int  size() const;
+        int  offset(const Grid &map, int dir) const;
+        bool canMove(const Grid &map, uint32_t from, uint32_t to, int dir) const;
+    };
+
+    /// @brief Cost policy forwarding to computeCost().
+    struct HookCost {
+        using Score = double;
+
+        const PathFinder *finder = nullptr;
+
+        Score step(const Grid &map, const SearchNode<Score> &from, uint32_t to, int dir) const;
+        bool  uniform(const Grid &map) const;
+        bool  directional() const;
+    };
+
+    using HookSolver = BasicQuerySolver<Grid, HookNeighborhood, HookCost, ZeroHeuristic>;
+
+    bool        isPlain() const;
+    HookSolver &hooks() const;
+    void        instrument() const;
+    bool        separated(uint32_t start, uint32_t end) const;
+    void        searchFailed() const;
+    double      lastBound() const;
+    void        mapChanged();
+
 protected:
-    std::vector<std::vector<Type>>          map;
-    std::vector<math::Vector2>              solution;
-    std::vector<std::vector<math::Vector2>> equivalentPaths;
-    double                                  minCost;
+    Grid                                            map;
+    uint32_t                                        startCell = 0;
+    uint32_t                                        endCell   = 0;
+    Strategy                                        strategy  = Strategy::A_STAR;
+    std::vector<math::Vector2>                      solution;
+    mutable std::shared_ptr<const PathDag>          optimalPaths;
+    mutable bool                                    pendingAlternatives = false;
+    double                                          minCost;
+    double                                          costBound = std::numeric_limits<double>::infinity();
+    mutable QuerySolver                             solver;
+    mutable HookSolver                              hookSolver;
+    mutable ConnectedComponents<>                   components;
+    mutable SearchStats                             searchStats;
+    bool                                            statsEnabled = false;
+    TraceCallback                                   trace;
 
 protected:
-    virtual Node                           onStart(const math::Vector2 &pos) const;
-    virtual bool                           inside(const math::Vector2 &pos) const;
-    virtual bool                           canMove(const math::Vector2 &pos, const math::Vector2 &target) const;
-    virtual std::vector<math::Vector2>     getValidDirections() const;
-    virtual double                         computeCost(const Node &current, const math::Vector2 &target) const;
-    virtual double                         computeHeuristic(const math::Vector2 &pos, const math::Vector2 &target) const;
-    virtual std::vector<std::vector<Type>> parse(const std::vector<std::string> &data) const;
-    std::vector<math::Vector2>             solve_a_star();
+    virtual Node                       onStart(const math::Vector2 &pos) const;
+    virtual bool                       inside(const math::Vector2 &pos) const;
+    virtual bool                       canMove(const math::Vector2 &pos, const math::Vector2 &target) const;
+    virtual std::vector<math::Vector2> getValidDirections() const;
+    virtual double                     computeCost(const Node &current, const math::Vector2 &target) const;
+    virtual double                     computeHeuristic(const math::Vector2 &pos, const math::Vector2 &target) const;
+    virtual Grid                       parse(const std::vector<std::string> &data) const;
+    std::vector<math::Vector2>         solve_a_star();
+    std::vector<math::Vector2>         solve_single_path();
+    double                             searchEquivalents(double bound) const;
+    const std::vector<uint32_t>       *searchPath(uint32_t start, uint32_t end, double &cost);
 
 public:
     PathFinder()  = default;
     ~PathFinder() = default;
 
     void                                    set(const std::vector<std::string> &data);
+    bool                                    load(const std::string &path);
+    void                                    updateCell(int x, int y, Type type);
+    void                                    setStrategy(Strategy strategy);
+    void                                    setEpsilon(double epsilon);
+    void                                    setMemoryBudget(size_t bytes);
+    void                                    setAnytimeLimits(std::chrono::nanoseconds deadline, uint64_t expansions = 0);
+    void                                    setStatsEnabled(bool enabled);
+    void                                    setTrace(TraceCallback trace);
+    const SearchStats                      &stats() const;
+    const Grid                             &getMap() const;
     std::vector<math::Vector2>              solve();
-    std::vector<std::vector<math::Vector2>> alternatives() const;
+    std::vector<QueryResult>                solveBatch(const std::vector<Query> &queries);
+    void                                    solveBatch(const std::vector<Query> &queries, std::vector<QueryResult> &results);
+    OptimalPaths<math::Vector2>             alternatives() const;
     double                                  cost() const;
+    double                                  bound() const;
     void                                    dump() const;
 };
 
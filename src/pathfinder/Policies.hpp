@@ -0,0 +1,378 @@
+#pragma once
+
+#include <pathfinder/Grid.hpp>
+#include <pathfinder/SearchCore.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+#include <utility>
+
+namespace cam::pathfinder {
+
+/// @brief The four straight moves, in the same order as PathFinder::getValidDirections().
+///
+/// A neighborhood policy provides the moves of a map:
+///
+///     int  size() const;                                                      // number of directions
+///     int  offset(const Map &map, int dir) const;                             // cell id offset of a direction
+///     bool canMove(const Map &map, uint32_t from, uint32_t to, int dir) const; // checks if the move is allowed
+struct FourNeighborhood {
+    static constexpr int SIZE     = 4;
+    static constexpr int DX[SIZE] = {0, 1, 0, -1};
+    static constexpr int DY[SIZE] = {-1, 0, 1, 0};
+
+    inline int
+    size() const {
+        return SIZE;
+    }
+    template<typename Map>
+    inline int
+    offset(const Map &map, int dir) const {
+        return map.offset(DX[dir], DY[dir]);
+    }
+    template<typename Map>
+    inline bool
+    canMove(const Map &map, uint32_t from, uint32_t to, int dir) const {
+        return !map.isBlocked(to);
+    }
+};
+
+/// @brief How diagonal moves may go around the corners of blocked cells.
+enum class CornerCutting {
+    ALLOWED,        // diagonals ignore the two cells they go between
+    IF_ONE_FREE,    // diagonals can't squeeze between two blocked cells
+    FORBIDDEN,      // diagonals need both cells they go between free, so paths never touch a corner
+};
+
+/// @brief The four straight moves followed by the four diagonal ones, clockwise from up and from up-right.
+///
+/// A diagonal move goes between two straight neighbors of the cell it leaves, `from + DX` and `to - DX`, so checking
+/// the corner rule takes two more loads and no multiplication.
+struct EightNeighborhood {
+    static constexpr int SIZE     = 8;
+    static constexpr int DX[SIZE] = {0, 1, 0, -1, 1, 1, -1, -1};
+    static constexpr int DY[SIZE] = {-1, 0, 1, 0, -1, 1, 1, -1};
+
+    CornerCutting corners = CornerCutting::FORBIDDEN;
+
+    inline int
+    size() const {
+        return SIZE;
+    }
+    template<typename Map>
+    inline int
+    offset(const Map &map, int dir) const {
+        return map.offset(DX[dir], DY[dir]);
+    }
+    template<typename Map>
+    inline bool
+    canMove(const Map &map, uint32_t from, uint32_t to, int dir) const {
+        if(map.isBlocked(to)) {
+            return false;
+        }
+        if(dir < 4 || corners == CornerCutting::ALLOWED) {
+            return true;
+        }
+        const bool first  = map.isBlocked(from + DX[dir]);
+        const bool second = map.isBlocked(to - DX[dir]);
+        return corners == CornerCutting::IF_ONE_FREE ? !(first && second) : !(first || second);
+    }
+};
+
+/// @brief The six moves of a hexagonal map, clockwise from the upper left one. Cells are stored in axial coordinates: x
+/// is the column and y the row, every row shifted half a cell right from the one above, so the map is a rhombus and the
+/// six neighbors are at constant offsets.
+struct HexNeighborhood {
+    static constexpr int SIZE     = 6;
+    static constexpr int DX[SIZE] = {0, 1, 1, 0, -1, -1};
+    static constexpr int DY[SIZE] = {-1, -1, 0, 1, 1, 0};
+
+    inline int
+    size() const {
+        return SIZE;
+    }
+    template<typename Map>
+    inline int
+    offset(const Map &map, int dir) const {
+        return map.offset(DX[dir], DY[dir]);
+    }
+    template<typename Map>
+    inline bool
+    canMove(const Map &map, uint32_t from, uint32_t to, int dir) const {
+        return !map.isBlocked(to);
+    }
+};
+
+/// @brief Every move costs one.
+///
+/// A cost policy provides the score type and the score once a move is done. It optionally tells if every move of a map
+/// costs one, which lets Jump Point Search run on it, and if moves cost the same whatever the direction their start
+/// cell was reached from, which lets the search prune per cell instead of per slot. Without directional() they are
+/// assumed to depend on it:
+///
+///     using Score = ...;
+///     Score step(const Map &map, const SearchNode<Score> &from, uint32_t to, int dir) const;
+///     bool  uniform(const Map &map) const;
+///     bool  directional() const;
+struct UnitCost {
+    using Score = int;
+
+    template<typename Map>
+    inline Score
+    step(const Map &map, const SearchNode<Score> &from, uint32_t to, int dir) const {
+        return from.g + 1;
+    }
+    template<typename Map>
+    inline bool
+    uniform(const Map &map) const {
+        return true;
+    }
+    inline bool
+    directional() const {
+        return false;
+    }
+};
+
+/// @brief Moves cost the weight of the cell entered, see Grid::weight().
+struct TerrainCost {
+    using Score = int;
+
+    template<typename Map>
+    inline Score
+    step(const Map &map, const SearchNode<Score> &from, uint32_t to, int dir) const {
+        return from.g + map.weight(to);
+    }
+    template<typename Map>
+    inline bool
+    uniform(const Map &map) const {
+        return !map.isWeighted();
+    }
+    inline bool
+    directional() const {
+        return false;
+    }
+};
+
+/// @brief Moves of an EightNeighborhood cost STRAIGHT or DIAGONAL times the weight of the cell entered, integers close
+/// to the lengths of the moves so scores stay exact and fit the bucket queue.
+template<int STRAIGHT = 10, int DIAGONAL = 14>
+struct OctileCost {
+    using Score = int;
+
+    template<typename Map>
+    inline Score
+    step(const Map &map, const SearchNode<Score> &from, uint32_t to, int dir) const {
+        return from.g + (dir < 4 ? STRAIGHT : DIAGONAL) * map.weight(to);
+    }
+    inline bool
+    directional() const {
+        return false;
+    }
+};
+
+/// @brief Manhattan distance, admissible for the four straight moves of cost one.
+///
+/// A heuristic policy estimates the cost to the goal from the signed distance to it, in cells, or from both cell ids
+/// when it needs per cell data (see LandmarkHeuristic):
+///
+///     Score operator()(int dx, int dy) const;
+///     Score operator()(const Map &map, uint32_t cell, uint32_t goal) const;
+struct ManhattanHeuristic {
+    inline int
+    operator()(int dx, int dy) const {
+        return std::abs(dx) + std::abs(dy);
+    }
+};
+
+/// @brief Octile distance, the cost of the best path on an empty map with the moves of OctileCost: diagonal moves while
+/// both coordinates differ, straight ones for the rest.
+template<int STRAIGHT = 10, int DIAGONAL = 14>
+struct OctileHeuristic {
+    inline int
+    operator()(int dx, int dy) const {
+        const int low  = std::min(std::abs(dx), std::abs(dy));
+        const int high = std::max(std::abs(dx), std::abs(dy));
+        return STRAIGHT * high + (DIAGONAL - STRAIGHT) * low;
+    }
+};
+
+/// @brief Number of moves between two cells of a HexNeighborhood map, admissible for moves of cost one.
+struct HexHeuristic {
+    inline int
+    operator()(int dx, int dy) const {
+        return (std::abs(dx) + std::abs(dy) + std::abs(dx + dy)) / 2;
+    }
+};
+
+/// @brief No estimation at all, the search behaves as Dijkstra.
+struct ZeroHeuristic {
+    inline int
+    operator()(int dx, int dy) const {
+        return 0;
+    }
+};
+
+/// @brief Checks if a cost policy has the optional uniform() method.
+template<typename Cost, typename Map, typename = void>
+struct TellsUniform : std::false_type {};
+template<typename Cost, typename Map>
+struct TellsUniform<Cost, Map, std::void_t<decltype(std::declval<const Cost &>().uniform(std::declval<const Map &>()))>> : std::true_type {};
+
+/// @brief Checks if a cost policy has the optional directional() method.
+template<typename Cost, typename = void>
+struct TellsDirectional : std::false_type {};
+template<typename Cost>
+struct TellsDirectional<Cost, std::void_t<decltype(std::declval<const Cost &>().directional())>> : std::true_type {};
+
+/// @brief Number of directions of neighborhood policies with a constant SIZE, 0 for the others.
+template<typename Neighborhood, typename = void>
+struct FixedDirections : std::integral_constant<int, 0> {};
+template<typename Neighborhood>
+struct FixedDirections<Neighborhood, std::void_t<decltype(Neighborhood::SIZE)>> : std::integral_constant<int, Neighborhood::SIZE> {};
+
+/// @brief Estimates the cost between two cells with a heuristic policy, in whichever form the policy takes.
+template<typename Heuristic, typename Map>
+inline auto
+estimate(const Heuristic &heuristic, const Map &map, uint32_t from, uint32_t to) {
+    if constexpr(std::is_invocable_v<const Heuristic &, const Map &, uint32_t, uint32_t>) {
+        return heuristic(map, from, to);
+    } else {
+        const int stride = map.getStride();
+        return heuristic((int)(to % stride) - (int)(from % stride), (int)(to / stride) - (int)(from / stride));
+    }
+}
+
+/// @brief SearchCore policy built from compile-time map, neighborhood, cost and heuristic policies.
+///
+/// Every call is resolved at compile time, so the search loop inlines the whole policy. Positions are computed from the
+/// cell ids, so the heuristic needs no lookup. The offsets of neighborhoods with a constant SIZE are computed once for
+/// the stride of the map, so finding a neighbor is a single load from a table.
+/// @tparam Map Grid like type with `offset`, `isBlocked` and `getStride`.
+template<typename Map, typename Neighborhood, typename Cost, typename Heuristic>
+class GridPolicy {
+    static constexpr int TABLE = FixedDirections<Neighborhood>::value;
+
+    const Map             &map;
+    Neighborhood           neighborhood;
+    Cost                   costs;
+    Heuristic              estimation;
+    uint32_t               goal;
+    int                    stride;
+    int                    goalX;
+    int                    goalY;
+    std::array<int, TABLE> offsets;    // offset of every direction, empty if their number isn't constant
+
+public:
+    using Score = typename Cost::Score;
+
+    GridPolicy(const Map &map, uint32_t goal, Neighborhood neighborhood = {}, Cost costs = {}, Heuristic heuristic = {})
+        : map(map), neighborhood(std::move(neighborhood)), costs(std::move(costs)), estimation(std::move(heuristic)),
+          goal(goal), stride(map.getStride()), goalX(goal % stride), goalY(goal / stride) {
+        for(int dir = 0; dir < TABLE; dir++) {
+            offsets[dir] = this->neighborhood.offset(map, dir);
+        }
+    }
+
+    inline int
+    directions() const {
+        if constexpr(TABLE > 0) {
+            return TABLE;
+        } else {
+            return neighborhood.size();
+        }
+    }
+    inline int
+    offset(int dir) const {
+        if constexpr(TABLE > 0) {
+            return offsets[dir];
+        } else {
+            return neighborhood.offset(map, dir);
+        }
+    }
+    inline bool
+    canMove(uint32_t from, uint32_t to, int dir) const {
+        return neighborhood.canMove(map, from, to, dir);
+    }
+    inline Score
+    step(const SearchNode<Score> &from, uint32_t to, int dir) const {
+        return costs.step(map, from, to, dir);
+    }
+    /// @brief Checks if every move costs one, false if the cost policy doesn't tell.
+    inline bool
+    uniform() const {
+        if constexpr(TellsUniform<Cost, Map>::value) {
+            return costs.uniform(map);
+        } else {
+            return false;
+        }
+    }
+    /// @brief Checks if moves depend on the direction their start cell was reached from, true if the cost policy
+    /// doesn't tell.
+    inline bool
+    directional() const {
+        if constexpr(TellsDirectional<Cost>::value) {
+            return costs.directional();
+        } else {
+            return true;
+        }
+    }
+    inline Score
+    heuristic(uint32_t cell) const {
+        if constexpr(std::is_invocable_v<const Heuristic &, const Map &, uint32_t, uint32_t>) {
+            return estimation(map, cell, goal);
+        } else {
+            return estimation(goalX - (int)(cell % stride), goalY - (int)(cell / stride));
+        }
+    }
+};
+
+/// @brief SearchCore policy with the heuristic of another one inflated by a factor, for weighted A*.
+///
+/// The search stops as soon as no queued node can beat the best arrival by the inflated estimation, so it expands far
+/// fewer nodes while the cost of the path found stays within `epsilon` times the optimal one.
+template<typename Policy>
+class InflatedPolicy {
+    const Policy &policy;
+    double        epsilon;
+
+public:
+    using Score = typename Policy::Score;
+
+    InflatedPolicy(const Policy &policy, double epsilon) : policy(policy), epsilon(epsilon) {}
+
+    inline int
+    directions() const {
+        return policy.directions();
+    }
+    inline int
+    offset(int dir) const {
+        return policy.offset(dir);
+    }
+    inline bool
+    canMove(uint32_t from, uint32_t to, int dir) const {
+        return policy.canMove(from, to, dir);
+    }
+    inline Score
+    step(const SearchNode<Score> &from, uint32_t to, int dir) const {
+        return policy.step(from, to, dir);
+    }
+    inline Score
+    heuristic(uint32_t cell) const {
+        return (Score)(policy.heuristic(cell) * epsilon);
+    }
+    inline bool
+    directional() const {
+        return policy.directional();
+    }
+};
+
+/// @brief SearchCore policy for 4-connected grids where every move costs one.
+///
+/// Scores are integers and the heuristic is the manhattan distance computed from the cell ids, so the search loop has
+/// no floating point work at all.
+using UnitCostPolicy = GridPolicy<Grid, FourNeighborhood, UnitCost, ManhattanHeuristic>;
+
+}    // namespace cam::pathfinder
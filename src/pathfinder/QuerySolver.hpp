@@ -0,0 +1,288 @@
+#pragma once
+
+#include <math/Vector2.hpp>
+#include <pathfinder/BidirectionalSearch.hpp>
+#include <pathfinder/AnytimeSearch.hpp>
+#include <pathfinder/Grid.hpp>
+#include <pathfinder/IterativeDeepeningSearch.hpp>
+#include <pathfinder/JumpPointSearch.hpp>
+#include <pathfinder/MemoryBoundedSearch.hpp>
+#include <pathfinder/Policies.hpp>
+#include <pathfinder/SearchCore.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace cam::pathfinder {
+
+/// @brief Search algorithm used to solve a path.
+enum class Strategy {
+    A_STAR,                 // A* listing every equivalent optimal path
+    JUMP_POINT,             // Jump Point Search, for uniform cost 4-connected maps. Equivalent paths on request.
+    BIDIRECTIONAL,          // A* from both ends at once, for reversible moves. Equivalent paths on request.
+    WEIGHTED_A_STAR,        // A* with an inflated heuristic, paths cost at most epsilon times the optimal one.
+    ITERATIVE_DEEPENING,    // IDA*, holding the current path and a transposition table within the memory budget.
+    MEMORY_BOUNDED,         // SMA*, evicting the worst queued nodes to stay within the memory budget.
+    ANYTIME,                // ARA*, returning the best path found within the limits and improving it on the next calls.
+};
+
+/// @brief Start and end positions of a path query.
+using Query = std::pair<math::Vector2i, math::Vector2i>;
+
+/// @brief Path found for a query, empty with the maximum double cost when there is none.
+struct QueryResult {
+    std::vector<math::Vector2i> path;
+    double                      cost;
+    double                      bound = std::numeric_limits<double>::infinity();    // suboptimality bound of the cost
+};
+
+/// @brief Solves path queries on a map given with every call, using compile-time policies (see Policies.hpp).
+///
+/// Owns the buffers of every strategy and only reads the map it is given, so any number of solvers can work on the same
+/// map at once as long as each one is used by a single thread.
+template<typename Map, typename Neighborhood, typename Cost, typename Heuristic>
+class BasicQuerySolver {
+public:
+    using Score  = typename Cost::Score;
+    using Policy = GridPolicy<Map, Neighborhood, Cost, Heuristic>;
+    using Path   = std::vector<uint32_t>;
+
+private:
+    Neighborhood                    neighborhood;
+    Cost                            costs;
+    Heuristic                       heuristic;
+    SearchCore<Score>               core;
+    JumpPointSearch<Score>          jump;
+    BidirectionalSearch<Score>      bidirectional;
+    IterativeDeepeningSearch<Score> deepening;
+    MemoryBoundedSearch<Score>      bounded;
+    AnytimeSearch<Score>            anytime;
+    double                          epsilon   = 1.5;
+    double                          lastBound = std::numeric_limits<double>::infinity();
+
+public:
+    explicit BasicQuerySolver(Neighborhood neighborhood = {}, Cost costs = {}, Heuristic heuristic = {})
+        : neighborhood(std::move(neighborhood)), costs(std::move(costs)), heuristic(std::move(heuristic)) {
+    }
+
+    /// @brief Replaces the policies used by the next searches.
+    void
+    setPolicies(Neighborhood neighborhood, Cost costs, Heuristic heuristic = {}) {
+        this->neighborhood = std::move(neighborhood);
+        this->costs        = std::move(costs);
+        this->heuristic    = std::move(heuristic);
+    }
+
+    /// @brief Sets the suboptimality bound of WEIGHTED_A_STAR, and the one of the first path of ANYTIME, at least 1.
+    inline void
+    setEpsilon(double epsilon) {
+        this->epsilon = epsilon < 1.0 ? 1.0 : epsilon;
+        anytime.setEpsilon(this->epsilon);
+    }
+
+    inline double
+    getEpsilon() const {
+        return epsilon;
+    }
+
+    /// @brief Sets the memory every search of ITERATIVE_DEEPENING and MEMORY_BOUNDED may hold, in bytes. Their buffers
+    /// are allocated at once and kept at that size, 16 MiB by default. Searches reaching it count in
+    /// SearchStats::budgetHits.
+    void
+    setMemoryBudget(size_t bytes) {
+        deepening.setBudget(bytes);
+        bounded.setBudget(bytes);
+    }
+
+    inline size_t
+    getMemoryBudget() const {
+        return bounded.getBudget();
+    }
+
+    /// @brief Limits every search of ANYTIME to a wall time and a number of expansions, zero meaning no limit.
+    inline void
+    setAnytimeLimits(std::chrono::nanoseconds deadline, uint64_t expansions = 0) {
+        anytime.setLimits(deadline, expansions);
+    }
+
+    /// @brief Makes the next ANYTIME search start over instead of improving the path of the same query, to call once
+    /// the map changed.
+    inline void
+    restart() {
+        anytime.restart();
+    }
+
+    /// @brief Suboptimality bound of the last search: the cost of its path is at most this many times the optimal one.
+    /// Infinity if no path was found, or if a memory bounded search reached its budget, as nothing is known then.
+    inline double
+    bound() const {
+        return lastBound;
+    }
+
+    /// @brief True if the last search of a memory bounded strategy reached its budget, so the path found may not be
+    /// optimal and a missing one may exist.
+    inline bool
+    boundHit(Strategy strategy) const {
+        switch(strategy) {
+            case Strategy::ITERATIVE_DEEPENING:
+                return deepening.boundHit();
+            case Strategy::MEMORY_BOUNDED:
+                return bounded.boundHit();
+            default:
+                return false;
+        }
+    }
+
+    /// @brief Adds the statistics of the next searches of every strategy to the given counters, reporting every
+    /// expansion to a trace. Both must outlive the searches, and a null stats pointer disables them.
+    void
+    instrument(SearchStats *stats, const TraceCallback *trace = nullptr) {
+        core.instrument(stats, trace);
+        jump.instrument(stats, trace);
+        bidirectional.instrument(stats, trace);
+        deepening.instrument(stats, trace);
+        bounded.instrument(stats, trace);
+        anytime.instrument(stats, trace);
+    }
+
+    /// @brief SearchCore policy towards a goal cell.
+    inline Policy
+    policy(const Map &map, uint32_t goal) const {
+        return Policy(map, goal, neighborhood, costs, heuristic);
+    }
+
+    /// @brief Searches a single optimal path between two cells, or a bounded suboptimal one with WEIGHTED_A_STAR. Jump
+    /// Point Search falls back to A* when the neighborhood isn't the four straight moves or moves don't all cost one,
+    /// and the bidirectional search when moves depend on the direction a cell was reached from, as it meets per cell.
+    /// The memory bounded strategies may find a longer path, or none, when the optimal one doesn't fit their budget,
+    /// and ANYTIME the best path found within its limits. See bound().
+    /// @param map Map to search.
+    /// @param strategy Algorithm used to search.
+    /// @param start Cell id where the path starts.
+    /// @param end Cell id where the path ends.
+    /// @param cost Output with the cost of the path.
+    /// @return The cell ids of the path, or nullptr if there is none. It is valid until the next search.
+    const Path *
+    search(const Map &map, Strategy strategy, uint32_t start, uint32_t end, Score &cost) {
+        cost      = SearchCore<Score>::INFINITE;
+        lastBound = std::numeric_limits<double>::infinity();
+
+        const Policy forward = policy(map, end);
+        switch(strategy) {
+            case Strategy::JUMP_POINT:
+                if(forward.uniform() && JumpPointSearch<Score>::supports(forward, map.getStride())) {
+                    if(jump.run(forward, map.size(), map.getStride(), start, end)) {
+                        cost      = jump.cost();
+                        lastBound = 1.0;
+                        return &jump.path();
+                    }
+                    return nullptr;
+                }
+                break;
+            case Strategy::BIDIRECTIONAL:
+                if(!forward.directional()) {
+                    if(bidirectional.run(forward, policy(map, start), map.size(), start, end)) {
+                        cost      = bidirectional.cost();
+                        lastBound = 1.0;
+                        return &bidirectional.path();
+                    }
+                    return nullptr;
+                }
+                break;
+            case Strategy::WEIGHTED_A_STAR:
+                core.setEquivalents(false);
+                if(core.run(InflatedPolicy<Policy>(forward, epsilon), map.size(), start, end)) {
+                    cost      = core.cost();
+                    lastBound = epsilon;
+                    return &core.path();
+                }
+                return nullptr;
+            case Strategy::ITERATIVE_DEEPENING:
+                if(deepening.run(forward, start, end)) {
+                    cost      = deepening.cost();
+                    lastBound = deepening.boundHit() ? lastBound : 1.0;
+                    return &deepening.path();
+                }
+                return nullptr;
+            case Strategy::MEMORY_BOUNDED:
+                if(bounded.run(forward, start, end)) {
+                    cost      = bounded.cost();
+                    lastBound = bounded.boundHit() ? lastBound : 1.0;
+                    return &bounded.path();
+                }
+                return nullptr;
+            case Strategy::ANYTIME:
+                if(anytime.run(forward, map.size(), start, end)) {
+                    cost      = anytime.cost();
+                    lastBound = anytime.bound();
+                    return &anytime.path();
+                }
+                return nullptr;
+            default:
+                break;
+        }
+
+        core.setEquivalents(false);
+        if(core.run(forward, map.size(), start, end)) {
+            cost      = core.cost();
+            lastBound = 1.0;
+            return &core.path();
+        }
+        return nullptr;
+    }
+
+    /// @brief Searches every optimal path between two cells with A*.
+    /// @param cost Output with the cost of the paths.
+    /// @param bound Known upper bound of the optimal cost.
+    /// @param g Initial score of the start cell.
+    /// @param dir Initial direction of the start cell.
+    /// @return The graph of every optimal path, or nullptr if there is none. It is valid until the next search.
+    const PathDag *
+    searchEquivalents(const Map &map, uint32_t start, uint32_t end, Score &cost, Score bound = SearchCore<Score>::INFINITE,
+                      Score g = 0, int dir = 0) {
+        cost = SearchCore<Score>::INFINITE;
+        core.setEquivalents(true);
+        if(core.run(policy(map, end), map.size(), start, end, g, dir, bound)) {
+            cost = core.cost();
+            return &core.dag();
+        }
+        return nullptr;
+    }
+
+    /// @brief Solves a query given in map positions. Endpoints outside the map or on a BLOCK cell have no path.
+    /// @param result Output, its path storage is reused.
+    void
+    solve(const Map &map, Strategy strategy, const Query &query, QueryResult &result) {
+        const auto &[from, to] = query;
+
+        result.path.clear();
+        result.cost  = std::numeric_limits<double>::max();
+        result.bound = std::numeric_limits<double>::infinity();
+        if(!map.inside(from.getX(), from.getY()) || !map.inside(to.getX(), to.getY())) {
+            return;
+        }
+
+        const uint32_t start = map.index(from.getX(), from.getY());
+        const uint32_t end   = map.index(to.getX(), to.getY());
+        if(map.isBlocked(start) || map.isBlocked(end)) {
+            return;
+        }
+
+        Score cost;
+        if(const Path *cells = search(map, strategy, start, end, cost); cells != nullptr) {
+            result.cost  = cost;
+            result.bound = lastBound;
+            for(uint32_t cell : *cells) {
+                result.path.push_back(map.position(cell));
+            }
+        }
+    }
+};
+
+/// @brief Solves single path queries on 4-connected grids, moves costing the weight of the cell entered.
+using QuerySolver = BasicQuerySolver<Grid, FourNeighborhood, TerrainCost, ManhattanHeuristic>;
+
+}    // namespace cam::pathfinder
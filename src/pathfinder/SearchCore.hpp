@@ -0,0 +1,297 @@
+#pragma once
+
+#include <pathfinder/ClosedSet.hpp>
+#include <pathfinder/OpenSet.hpp>
+#include <pathfinder/PathDag.hpp>
+#include <pathfinder/SearchStats.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace cam::pathfinder {
+
+/// @brief Search status of a (cell, direction) slot inside the search core.
+/// @tparam Cost Type of the scores, an integer type for unit or integer cost grids.
+template<typename Cost>
+struct SearchNode {
+    Cost     f;
+    Cost     g;
+    uint32_t cell;
+    int      dir;
+    int      parent;
+
+    /// @brief Orders the open set by lowest f first, breaking ties towards the deepest node.
+    bool
+    operator>(const SearchNode &other) const {
+        return f > other.f || (f == other.f && g < other.g);
+    }
+};
+
+/// @brief A* search over the cell ids of a Grid.
+///
+/// The core keeps every buffer it needs between runs, so several queries on the same map don't reallocate. Everything
+/// map specific is provided by a policy object with this interface:
+///
+///     int  directions() const;                                            // number of neighbor directions
+///     int  offset(int dir) const;                                         // cell id offset of every direction
+///     bool canMove(uint32_t from, uint32_t to, int dir) const;            // checks if the move is allowed
+///     Cost step(const SearchNode<Cost> &from, uint32_t to, int dir) const; // score once moved to the target cell
+///     Cost heuristic(uint32_t cell) const;                                // admissible estimation to the goal
+///     bool directional() const;                                           // checks if step() depends on from.dir
+///
+/// Nodes are tracked per (cell, direction) slot, so move costs may depend on the direction a cell was reached from, as
+/// long as directional() tells so. Otherwise a cell closed once prunes every later arrival at it with a higher score.
+/// When every optimal path is requested, the slots lying on them are linked into a PathDag once the search is over. The
+/// open set is keyed by slot, so a slot reached again with a lower score is updated in place instead of queued twice,
+/// in buckets while the scores are small integers (see OpenSet). Arrivals at the goal are recorded as soon as they are
+/// generated and never queued.
+/// @tparam Cost Type of the scores.
+template<typename Cost>
+class SearchCore {
+public:
+    using Node = SearchNode<Cost>;
+    using Path = std::vector<uint32_t>;
+
+    static constexpr Cost INFINITE = std::numeric_limits<Cost>::max();
+
+private:
+    OpenSet<Node>        openSet;
+    std::vector<int>     parents;
+    ClosedSet<Cost>      slots;
+    ClosedSet<Cost>      closed;
+    std::vector<int>     arrivals;    // slots the goal was reached from with the best score, -1 for the start
+    Path                 found;
+    PathDag              graph;
+    ClosedSet<uint32_t>  members;    // graph node of every slot on an optimal path
+    std::vector<int>     order;      // slot of every graph node
+    Cost                 best        = INFINITE;
+    bool                 equivalents = true;
+    SearchStats         *stats       = nullptr;
+    const TraceCallback *trace       = nullptr;
+
+    Path
+    rebuild(int slot, int ndirs, uint32_t goal) const {
+        Path path;
+        for(int it = slot; it >= 0; it = parents[it]) {
+            path.push_back(it / ndirs);
+        }
+        std::reverse(path.begin(), path.end());
+        path.push_back(goal);
+        return path;
+    }
+
+    inline void
+    arrive(Cost g, int parent) {
+        if(g < best) {
+            best = g;
+            arrivals.clear();
+        }
+        if(g == best) {
+            arrivals.push_back(parent);
+        }
+    }
+
+    inline uint32_t
+    member(int slot, int ndirs) {
+        if(members.contains(slot)) {
+            return members.score(slot);
+        }
+        const uint32_t node = graph.add(slot / ndirs);
+        members.close(slot, node);
+        order.push_back(slot);
+        return node;
+    }
+
+    /// @brief Links every slot on an optimal path to the closed slots it is optimally reached from, walking back from
+    /// the goal. The parent of every slot is linked first, so the first path of the graph is the one rebuilt by the
+    /// search.
+    template<typename Policy>
+    void
+    link(const Policy &policy, size_t cells, uint32_t goal) {
+        const int NDIRS = policy.directions();
+
+        graph.reset(cells, goal);
+        members.reset(cells * NDIRS);
+        order.assign(1, -1);
+
+        graph.open(0);
+        for(int slot : arrivals) {
+            if(slot >= 0) {
+                graph.link(member(slot, NDIRS));
+            }
+        }
+
+        for(uint32_t node = 1; node < graph.size(); node++) {
+            const int slot   = order[node];
+            const int parent = parents[slot];
+            graph.open(node);
+            if(parent < 0) {
+                continue;
+            }
+            graph.link(member(parent, NDIRS));
+
+            const uint32_t cell = slot / NDIRS;
+            const int      dir  = slot % NDIRS;
+            const uint32_t from = cell - policy.offset(dir);
+            if(!policy.canMove(from, cell, dir)) {
+                continue;
+            }
+            for(int idx = 0; idx < NDIRS; idx++) {
+                const int pred = from * NDIRS + idx;
+                if(pred != parent && slots.contains(pred) &&
+                   policy.step({0, slots.score(pred), from, idx, parents[pred]}, cell, dir) == slots.score(slot)) {
+                    graph.link(member(pred, NDIRS));
+                }
+            }
+        }
+        graph.finish();
+    }
+
+public:
+    /// @brief Collects statistics of the next runs, adding them to the given counters, and reports every expansion to
+    /// a trace. The trace is only called while statistics are collected. Null pointers disable them.
+    inline void
+    instrument(SearchStats *stats, const TraceCallback *trace = nullptr) {
+        this->stats = stats;
+        this->trace = trace;
+    }
+
+    /// @brief Memory held by the search buffers, in bytes.
+    inline size_t
+    bytes() const {
+        return openSet.bytes() + parents.capacity() * sizeof(int) + slots.bytes() + closed.bytes() + arrivals.capacity() * sizeof(int) +
+               found.capacity() * sizeof(uint32_t) + graph.bytes() + members.bytes() + order.capacity() * sizeof(int);
+    }
+
+    /// @brief Chooses between searching every optimal path (the default) or stopping at the first one.
+    inline void
+    setEquivalents(bool enabled) {
+        equivalents = enabled;
+    }
+
+    /// @brief Searches every optimal path between two cells.
+    /// @param policy Map specific operations, see the class description.
+    /// @param cells Number of cell ids of the map.
+    /// @param start Cell id where the search starts.
+    /// @param goal Cell id to reach.
+    /// @param g Initial score of the start cell.
+    /// @param dir Initial direction of the start cell.
+    /// @param bound Known upper bound of the optimal cost, nodes above it are pruned as soon as they are generated.
+    /// @return True if the goal was reached.
+    template<typename Policy>
+    bool
+    run(const Policy &policy, size_t cells, uint32_t start, uint32_t goal, Cost g = 0, int dir = 0, Cost bound = INFINITE) {
+        const int NDIRS = policy.directions();
+
+        found.clear();
+        arrivals.clear();
+        parents.resize(cells * NDIRS);
+        slots.reset(cells * NDIRS);
+        closed.reset(cells);
+        openSet.reset(cells * NDIRS);
+        best = bound;
+
+        if(start == goal) {
+            arrive(g, -1);
+        } else if(stats == nullptr) {
+            search(SearchProbe<false>(nullptr, nullptr), policy, start, goal, g, dir);
+        } else {
+            measure(stats, &SearchStats::searchTime, [&]() { search(SearchProbe<true>(stats, trace), policy, start, goal, g, dir); });
+        }
+
+        const bool reached = !arrivals.empty();
+        if(!reached) {
+            best = INFINITE;
+        } else {
+            measure(stats, &SearchStats::pathTime, [&]() { found = rebuild(arrivals.front(), NDIRS, goal); });
+            if(equivalents) {
+                measure(stats, &SearchStats::graphTime, [&]() { link(policy, cells, goal); });
+            }
+        }
+        if(stats != nullptr) {
+            stats->bytes = bytes();
+        }
+        return reached;
+    }
+
+    /// @brief First optimal path found by the last run, as a list of cell ids from start to goal.
+    inline const Path &
+    path() const {
+        return found;
+    }
+
+    /// @brief Every optimal path found by the last run, only filled when searching equivalent paths.
+    inline const PathDag &
+    dag() const {
+        return graph;
+    }
+
+    /// @brief Cost of the optimal paths found by the last run, INFINITE if the goal wasn't reached.
+    inline Cost
+    cost() const {
+        return best;
+    }
+
+private:
+    template<typename Probe, typename Policy>
+    void
+    search(Probe probe, const Policy &policy, uint32_t start, uint32_t goal, Cost g, int dir) {
+        const int  NDIRS   = policy.directions();
+        const bool perCell = !policy.directional();
+
+        openSet.push(start * NDIRS + dir, {g + policy.heuristic(start), g, start, dir, -1});
+        probe.push(openSet.size());
+        while(!openSet.empty()) {
+            // Once a path is known, a lower f is needed to find a better one, and an equal f to find an equivalent one
+            const Cost top = openSet.top().f;
+            if(top > best || (!equivalents && !arrivals.empty() && top >= best)) {
+                break;
+            }
+
+            Node      current = openSet.pop();
+            const int slot    = current.cell * NDIRS + current.dir;
+            probe.pop();
+            probe.expand(current.cell);
+            slots.close(slot, current.g);
+            parents[slot] = current.parent;
+            closed.close(current.cell, current.g);
+
+            for(int idx = 0; idx < NDIRS; idx++) {
+                const uint32_t next = current.cell + policy.offset(idx);
+                if(!policy.canMove(current.cell, next, idx)) {
+                    continue;
+                }
+
+                const Cost tentativeG = policy.step(current, next, idx);
+                const Cost tentativeF = tentativeG + policy.heuristic(next);
+                if(tentativeF > best) {
+                    continue;
+                }
+
+                if(next == goal) {
+                    arrive(tentativeG, slot);
+                    continue;
+                }
+
+                // When moves don't depend on the direction a cell was reached from, a cell closed with a lower score
+                // can't lead to an optimal path, which also rejects revisits of the current path in O(1). Otherwise a
+                // cheaper arrival from another direction may still cost more later, so only the slot itself is checked.
+                const int nextSlot = next * NDIRS + idx;
+                if((perCell && closed.closedBelow(next, tentativeG)) || slots.contains(nextSlot)) {
+                    probe.skip();
+                    continue;
+                }
+
+                if(openSet.push(nextSlot, {tentativeF, tentativeG, next, idx, slot})) {
+                    probe.push(openSet.size());
+                } else {
+                    probe.skip();
+                }
+            }
+        }
+    }
+};
+
+}    // namespace cam::pathfinder
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace cam::pathfinder {
+
+/// @brief Counters of the searches run while statistics are enabled. They add up over several searches until reset.
+struct SearchStats {
+    uint64_t                 pushed     = 0;    // nodes queued, including the ones lowering a queued node
+    uint64_t                 popped     = 0;    // nodes taken from the open set, including stale ones
+    uint64_t                 expanded   = 0;    // nodes whose neighbors were generated
+    uint64_t                 skipped    = 0;    // generated nodes dropped as already visited with a score not worse
+    size_t                   peakOpen   = 0;    // largest open set size
+    size_t                   bytes      = 0;    // memory held by the search buffers after the last search
+    uint64_t                 budgetHits = 0;    // memory bounded searches that reached their byte budget
+    std::chrono::nanoseconds searchTime{0};     // expanding nodes
+    std::chrono::nanoseconds pathTime{0};       // rebuilding the path found
+    std::chrono::nanoseconds graphTime{0};      // linking every optimal path into a PathDag
+
+    void
+    reset() {
+        *this = SearchStats();
+    }
+};
+
+/// @brief Called with every expanded cell id and its expansion order, starting at 0 on every search.
+using TraceCallback = std::function<void(uint32_t cell, uint64_t order)>;
+
+/// @brief Collects statistics for the searches. Searches are instantiated with either probe, so the disabled one
+/// compiles to nothing and costs nothing.
+template<bool ENABLED>
+struct SearchProbe {
+    inline SearchProbe(SearchStats *, const TraceCallback *) {}
+
+    inline void push(size_t) {}
+    inline void pop() {}
+    inline void expand(uint32_t) {}
+    inline void skip() {}
+};
+
+template<>
+struct SearchProbe<true> {
+    SearchStats         *stats;
+    const TraceCallback *trace;
+    uint64_t             order = 0;
+
+    inline SearchProbe(SearchStats *stats, const TraceCallback *trace) : stats(stats), trace(trace) {}
+
+    /// @param size Open set size after the push.
+    inline void
+    push(size_t size) {
+        stats->pushed++;
+        stats->peakOpen = std::max(stats->peakOpen, size);
+    }
+    inline void
+    pop() {
+        stats->popped++;
+    }
+    inline void
+    expand(uint32_t cell) {
+        stats->expanded++;
+        if(trace != nullptr && *trace) {
+            (*trace)(cell, order);
+        }
+        order++;
+    }
+    inline void
+    skip() {
+        stats->skipped++;
+    }
+};
+
+/// @brief Runs a function, adding its wall time to a phase of the statistics when they are collected.
+template<typename Function>
+inline void
+measure(SearchStats *stats, std::chrono::nanoseconds SearchStats::*phase, Function &&function) {
+    if(stats == nullptr) {
+        function();
+        return;
+    }
+    const auto begin = std::chrono::steady_clock::now();
+    function();
+    stats->*phase += std::chrono::steady_clock::now() - begin;
+}
+
+/// @brief Trace recording the expansion order of every cell, printed in the style of PathFinder::dump().
+///
+/// Cells are printed as the tenth of the search they were first expanded in, from '0' for the first expansions to '9'
+/// for the last ones, so the print shows how the search spread over the map.
+class ExpansionHeatmap {
+    std::vector<uint64_t> orders;    // expansion order plus one of every cell, 0 if never expanded
+    uint64_t              count = 0;
+
+public:
+    /// @brief Forgets the expansions of the previous searches.
+    void
+    clear() {
+        std::fill(orders.begin(), orders.end(), 0);
+        count = 0;
+    }
+
+    /// @brief Callback to install as trace. The heatmap must outlive it.
+    TraceCallback
+    callback() {
+        return [this](uint32_t cell, uint64_t order) {
+            if(order == 0) {
+                clear();
+            }
+            if(cell >= orders.size()) {
+                orders.resize(cell + 1, 0);
+            }
+            if(orders[cell] == 0) {
+                orders[cell] = order + 1;
+            }
+            count = std::max(count, order + 1);
+        };
+    }
+
+    /// @brief Number of expansions of the last search.
+    inline uint64_t
+    expansions() const {
+        return count;
+    }
+
+    /// @brief Checks if a cell was expanded by the last search.
+    inline bool
+    expanded(uint32_t cell) const {
+        return cell < orders.size() && orders[cell] != 0;
+    }
+
+    template<typename Map>
+    std::string
+    render(const Map &map) const {
+        std::stringstream ss;
+        ss << std::endl;
+        for(int y = 0; y < map.getHeight(); y++) {
+            for(int x = 0; x < map.getWidth(); x++) {
+                const uint32_t cell = map.index(x, y);
+                if(map.isBlocked(cell)) {
+                    ss << '#';
+                } else if(expanded(cell)) {
+                    ss << (char)('0' + (orders[cell] - 1) * 10 / count);
+                } else {
+                    ss << '.';
+                }
+            }
+            ss << std::endl;
+        }
+        return ss.str();
+    }
+
+    template<typename Map>
+    void
+    dump(const Map &map) const {
+        std::cout << render(map);
+    }
+};
+
+}    // namespace cam::pathfinder
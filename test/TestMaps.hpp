@@ -0,0 +1,44 @@
+#pragma once
+
+#include <pathfinder/PathFinder.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+/// @brief Fixtures shared by the strategy tests.
+namespace testmaps {
+
+/// @brief Same costs as PathFinder, through the hook: queries take the path of the engines reading the map back
+/// through computeCost().
+class HookedPathFinder : public cam::pathfinder::PathFinder {
+protected:
+    double
+    computeCost(const cam::pathfinder::Node &current, const cam::math::Vector2 &target) const override {
+        return PathFinder::computeCost(current, target);
+    }
+};
+
+/// @brief Walls dropped with the given probability, in percent, and heavier terrain on a tenth of the cells, between a
+/// start on the top left cell and an end on the bottom right one. Maps without a path are regenerated.
+inline std::vector<std::string>
+randomMap(int size, int density, uint32_t seed) {
+    std::mt19937                rng(seed);
+    std::vector<std::string>    rows;
+    cam::pathfinder::PathFinder check;
+    do {
+        rows.assign(size, std::string(size, '.'));
+        for(auto &row : rows) {
+            for(char &cell : row) {
+                const int roll = (int)(rng() % 100);
+                cell           = roll < density ? '#' : roll < density + 10 ? (char)('2' + rng() % 3) : '.';
+            }
+        }
+        rows.front().front() = 'S';
+        rows.back().back()   = 'E';
+        check.set(rows);
+    } while(check.solve().empty());
+    return rows;
+}
+
+}    // namespace testmaps
@@ -0,0 +1,172 @@
+#include <pathfinder/BasicPathFinder.hpp>
+#include <pathfinder/PathFinder.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <limits>
+
+#include "TestMaps.hpp"
+
+using namespace cam::pathfinder;
+using namespace cam::math;
+using namespace testmaps;
+
+TEST(AnytimeTest, ImprovesUntilOptimal) {
+    const auto data = randomMap(64, 25, 3);
+
+    PathFinder astar;
+    astar.set(data);
+    astar.solve();
+
+    PathFinder finder;
+    finder.set(data);
+    finder.setStrategy(Strategy::ANYTIME);
+    finder.setEpsilon(3.0);
+    finder.setAnytimeLimits(std::chrono::nanoseconds(0), 100);
+
+    double previous = std::numeric_limits<double>::max();
+    int    calls    = 0;
+    int    improved = 0;
+    do {
+        auto solution = finder.solve();
+        calls++;
+        if(solution.empty()) {
+            EXPECT_EQ(finder.bound(), std::numeric_limits<double>::infinity());
+            continue;
+        }
+        EXPECT_EQ(solution.front(), Vector2(0, 0));
+        EXPECT_EQ(solution.back(), Vector2(63, 63));
+
+        // The path returned is the one the cost was found for, even once later expansions moved the parents on it
+        double walked = 0;
+        for(size_t idx = 1; idx < solution.size(); idx++) {
+            EXPECT_EQ(solution[idx - 1].distance(solution[idx], MANHATTAN), 1.0);
+            walked += finder.getMap().weight((int)solution[idx].getX(), (int)solution[idx].getY());
+        }
+        EXPECT_EQ(walked, finder.cost());
+        EXPECT_LE(finder.cost(), previous);
+        EXPECT_GE(finder.cost(), astar.cost());
+        EXPECT_LE(finder.cost(), astar.cost() * finder.bound() + 1e-9);
+        EXPECT_LE(finder.bound(), 3.0);
+        improved += finder.cost() < previous;
+        previous = finder.cost();
+    } while(finder.bound() > 1.0 && calls < 10000);
+
+    EXPECT_GT(calls, 1);
+    EXPECT_GT(improved, 0);
+    EXPECT_EQ(finder.bound(), 1.0);
+    EXPECT_EQ(finder.cost(), astar.cost());
+
+    // Once optimal, further calls return the same path without searching
+    finder.setStatsEnabled(true);
+    EXPECT_EQ(finder.solve().size(), astar.solve().size());
+    EXPECT_EQ(finder.stats().expanded, 0);
+}
+
+TEST(AnytimeTest, DeadlineAndRestart) {
+    const auto data = randomMap(48, 25, 5);
+
+    PathFinder astar;
+    astar.set(data);
+    astar.solve();
+
+    PathFinder finder;
+    finder.set(data);
+    finder.setStrategy(Strategy::ANYTIME);
+    finder.setEpsilon(2.0);
+
+    // Without limits a single call reaches the optimal path
+    EXPECT_FALSE(finder.solve().empty());
+    EXPECT_EQ(finder.cost(), astar.cost());
+    EXPECT_EQ(finder.bound(), 1.0);
+
+    // Editing the map starts over, and the deadline stops the search before anything is found
+    finder.updateCell(1, 0, EMPTY);
+    astar.updateCell(1, 0, EMPTY);
+    astar.solve();
+    finder.setAnytimeLimits(std::chrono::nanoseconds(1));
+    EXPECT_TRUE(finder.solve().empty());
+    EXPECT_EQ(finder.bound(), std::numeric_limits<double>::infinity());
+
+    finder.setAnytimeLimits(std::chrono::milliseconds(100));
+    for(int call = 0; call < 100 && finder.bound() > 1.0; call++) {
+        finder.solve();
+    }
+    EXPECT_EQ(finder.cost(), astar.cost());
+
+    HookedPathFinder hooked;
+    hooked.set(data);
+    hooked.setStrategy(Strategy::ANYTIME);
+    hooked.updateCell(1, 0, EMPTY);
+    EXPECT_FALSE(hooked.solve().empty());
+    EXPECT_EQ(hooked.cost(), astar.cost());
+    EXPECT_EQ(hooked.bound(), 1.0);
+}
+
+TEST(AnytimeTest, TinyDeadline) {
+    const auto data = randomMap(30, 25, 9);
+
+    PathFinder astar;
+    astar.set(data);
+    astar.solve();
+
+    // Every call does a few expansions before reading the clock, so calling again keeps improving the path
+    PathFinder finder;
+    finder.set(data);
+    finder.setStrategy(Strategy::ANYTIME);
+    finder.setAnytimeLimits(std::chrono::nanoseconds(1));
+    int calls = 0;
+    while(finder.bound() > 1.0 && calls < 100000) {
+        finder.solve();
+        calls++;
+    }
+    EXPECT_GT(calls, 1);
+    EXPECT_EQ(finder.bound(), 1.0);
+    EXPECT_EQ(finder.cost(), astar.cost());
+}
+
+TEST(AnytimeTest, BoundOfEveryStrategy) {
+    const auto               data    = randomMap(24, 25, 7);
+    const std::vector<Query> queries = {{{0, 0}, {23, 23}}, {{23, 23}, {0, 0}}, {{0, 0}, {-1, 0}}};
+
+    PathFinder finder;
+    finder.set(data);
+    finder.setEpsilon(2.0);
+    finder.setAnytimeLimits(std::chrono::nanoseconds(0), 1 << 20);
+    for(auto [strategy, expected] : {std::make_pair(Strategy::A_STAR, 1.0), std::make_pair(Strategy::BIDIRECTIONAL, 1.0),
+                                     std::make_pair(Strategy::WEIGHTED_A_STAR, 2.0), std::make_pair(Strategy::ANYTIME, 1.0)}) {
+        finder.setStrategy(strategy);
+        finder.solve();
+        EXPECT_EQ(finder.bound(), expected);
+
+        auto results = finder.solveBatch(queries);
+        EXPECT_EQ(results[0].bound, expected);
+        EXPECT_EQ(results[1].bound, expected);
+        EXPECT_EQ(results[2].bound, std::numeric_limits<double>::infinity());
+    }
+}
+
+TEST(AnytimeTest, BasicPathFinder) {
+    Grid grid(32, 32);
+    for(int y = 0; y < 28; y++) {
+        grid.set(10, y, BLOCK);
+        grid.set(21, 31 - y, BLOCK);
+    }
+    grid.set(0, 0, START);
+    grid.set(31, 0, END);
+
+    OctilePathFinder astar;
+    astar.set(grid);
+    astar.solve();
+
+    OctilePathFinder finder;
+    finder.set(grid);
+    finder.setStrategy(Strategy::ANYTIME);
+    finder.setAnytimeLimits(std::chrono::nanoseconds(0), 50);
+    for(int call = 0; call < 1000 && finder.bound() > 1.0; call++) {
+        finder.solve();
+    }
+    EXPECT_EQ(finder.bound(), 1.0);
+    EXPECT_EQ(finder.cost(), astar.cost());
+}
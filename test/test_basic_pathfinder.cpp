@@ -0,0 +1,168 @@
+#include <pathfinder/BasicPathFinder.hpp>
+#include <pathfinder/PathFinder.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace cam::pathfinder;
+using namespace cam::math;
+
+namespace {
+
+// Moves cost two, with scores in doubles
+struct DoubleCost {
+    using Score = double;
+
+    template<typename Map>
+    Score
+    step(const Map &map, const SearchNode<Score> &from, uint32_t to, int dir) const {
+        return from.g + 2.0;
+    }
+};
+
+}    // namespace
+
+TEST(BasicPathFinderTest, MatchesPathFinder) {
+    std::vector<std::string> data = {"S..#......", ".#.#.####.", ".#...#....", ".####.#.#.", "......#.#E"};
+
+    PathFinder reference;
+    reference.set(data);
+    auto expected = reference.solve();
+
+    for(auto strategy : {Strategy::A_STAR, Strategy::JUMP_POINT, Strategy::BIDIRECTIONAL}) {
+        BasicPathFinder<> pathFinder;
+        pathFinder.set(reference.getMap());
+        pathFinder.setStrategy(strategy);
+
+        auto solution = pathFinder.solve();
+        ASSERT_EQ(solution.size(), expected.size());
+        EXPECT_EQ(solution.front(), Vector2i(0, 0));
+        EXPECT_EQ(solution.back(), Vector2i(9, 4));
+        EXPECT_EQ(pathFinder.cost(), reference.cost());
+        EXPECT_EQ(pathFinder.alternatives().size(), reference.alternatives().size());
+    }
+}
+
+TEST(BasicPathFinderTest, CustomPolicies) {
+    Grid grid(4, 3);
+    grid.set(0, 0, START);
+    grid.set(3, 2, END);
+    grid.set(1, 1, BLOCK);
+
+    BasicPathFinder<Grid, FourNeighborhood, DoubleCost, ZeroHeuristic> pathFinder;
+    pathFinder.set(grid);
+
+    auto solution = pathFinder.solve();
+    ASSERT_EQ(solution.size(), 6);
+    EXPECT_EQ(pathFinder.cost(), 10.0);
+    EXPECT_EQ(pathFinder.alternatives().size(), 4);
+
+    auto results = pathFinder.solveBatch({
+        {{0, 0}, {3, 0}},
+        {{0, 0}, {1, 1}}
+    });
+    EXPECT_EQ(results[0].cost, 6.0);
+    EXPECT_TRUE(results[1].path.empty());
+}
+
+TEST(BasicPathFinderTest, EightConnected) {
+    Grid open(5, 5);
+    open.set(0, 0, START);
+    open.set(4, 4, END);
+
+    OctilePathFinder pathFinder;
+    pathFinder.set(open);
+    EXPECT_EQ(pathFinder.solve().size(), 5);
+    EXPECT_EQ(pathFinder.cost(), 56);
+    EXPECT_EQ(pathFinder.alternatives().size(), 1);
+
+    // Squeezing between two walls, and brushing a single one
+    Grid squeeze(2, 2);
+    squeeze.set(0, 0, START);
+    squeeze.set(1, 1, END);
+    squeeze.set(1, 0, BLOCK);
+    squeeze.set(0, 1, BLOCK);
+    Grid corner(2, 2);
+    corner.set(0, 0, START);
+    corner.set(1, 1, END);
+    corner.set(0, 1, BLOCK);
+
+    const std::pair<CornerCutting, std::pair<int, int>> rules[] = {
+        {CornerCutting::ALLOWED,     {14, 14}                       },
+        {CornerCutting::IF_ONE_FREE, {SearchCore<int>::INFINITE, 14}},
+        {CornerCutting::FORBIDDEN,   {SearchCore<int>::INFINITE, 20}},
+    };
+    for(const auto &[rule, costs] : rules) {
+        OctilePathFinder cutting(EightNeighborhood{rule});
+        cutting.set(squeeze);
+        cutting.solve();
+        EXPECT_EQ(cutting.cost(), costs.first);
+        cutting.set(corner);
+        cutting.solve();
+        EXPECT_EQ(cutting.cost(), costs.second);
+    }
+}
+
+TEST(BasicPathFinderTest, Hexagonal) {
+    Grid open(5, 5);
+    open.set(0, 0, START);
+    open.set(4, 4, END);
+
+    HexPathFinder pathFinder;
+    pathFinder.set(open);
+    EXPECT_EQ(pathFinder.solve().size(), 9);
+    EXPECT_EQ(pathFinder.cost(), 8);
+
+    // Along the short diagonal of the rhombus every move gets closer
+    auto results = pathFinder.solveBatch({
+        {{4, 0}, {0, 4}}
+    });
+    EXPECT_EQ(results[0].cost, 4.0);
+}
+
+TEST(BasicPathFinderTest, AdmissibleHeuristics) {
+    std::mt19937                       rng(21);
+    std::uniform_int_distribution<int> coord(0, 19);
+    std::uniform_int_distribution<int> weight(1, 4);
+    std::bernoulli_distribution        wall(0.25);
+
+    for(int round = 0; round < 20; round++) {
+        Grid grid(20, 20);
+        for(int y = 0; y < 20; y++) {
+            for(int x = 0; x < 20; x++) {
+                if(wall(rng)) {
+                    grid.set(x, y, BLOCK);
+                } else {
+                    grid.setWeight(x, y, weight(rng));
+                }
+            }
+        }
+
+        std::vector<Query> queries;
+        for(int idx = 0; idx < 20; idx++) {
+            queries.push_back({Vector2i(coord(rng), coord(rng)), Vector2i(coord(rng), coord(rng))});
+        }
+
+        OctilePathFinder                                                      octile;
+        BasicPathFinder<Grid, EightNeighborhood, OctileCost<>, ZeroHeuristic> octileDijkstra;
+        HexPathFinder                                                         hex;
+        BasicPathFinder<Grid, HexNeighborhood, TerrainCost, ZeroHeuristic>    hexDijkstra;
+        octile.set(grid);
+        octileDijkstra.set(grid);
+        hex.set(grid);
+        hexDijkstra.set(grid);
+        for(auto strategy : {Strategy::A_STAR, Strategy::BIDIRECTIONAL}) {
+            octile.setStrategy(strategy);
+            hex.setStrategy(strategy);
+            auto octileResults  = octile.solveBatch(queries);
+            auto octileExpected = octileDijkstra.solveBatch(queries);
+            auto hexResults     = hex.solveBatch(queries);
+            auto hexExpected    = hexDijkstra.solveBatch(queries);
+            for(size_t idx = 0; idx < queries.size(); idx++) {
+                EXPECT_EQ(octileResults[idx].cost, octileExpected[idx].cost);
+                EXPECT_EQ(hexResults[idx].cost, hexExpected[idx].cost);
+            }
+        }
+    }
+}
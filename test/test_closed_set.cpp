@@ -0,0 +1,35 @@
+#include <pathfinder/ClosedSet.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace cam::pathfinder;
+
+TEST(ClosedSetTest, KeepsFirstScore) {
+    ClosedSet<double> closed;
+    closed.reset(4);
+
+    EXPECT_FALSE(closed.contains(2));
+    closed.close(2, 3.0);
+    closed.close(2, 1.0);
+
+    EXPECT_TRUE(closed.contains(2));
+    EXPECT_EQ(closed.score(2), 3.0);
+    EXPECT_TRUE(closed.closedBelow(2, 4.0));
+    EXPECT_FALSE(closed.closedBelow(2, 3.0));
+    EXPECT_FALSE(closed.closedBelow(1, 4.0));
+}
+
+TEST(ClosedSetTest, ResetStartsNewGeneration) {
+    ClosedSet<int> closed;
+    closed.reset(3);
+    closed.close(0, 1);
+    closed.close(1, 1);
+
+    closed.reset(3);
+    EXPECT_FALSE(closed.contains(0));
+    EXPECT_FALSE(closed.contains(1));
+
+    closed.reset(5);
+    EXPECT_EQ(closed.size(), 5);
+    EXPECT_FALSE(closed.contains(4));
+}
@@ -0,0 +1,166 @@
+#include <pathfinder/BasicPathFinder.hpp>
+#include <pathfinder/ConnectedComponents.hpp>
+#include <pathfinder/PathFinder.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace cam::pathfinder;
+using namespace cam::math;
+
+namespace {
+
+// Reference reachability with a breadth first search
+template<typename Neighborhood>
+bool
+reachable(const Grid &grid, const Neighborhood &neighborhood, uint32_t from, uint32_t to) {
+    if(grid.isBlocked(from) || grid.isBlocked(to)) {
+        return false;
+    }
+    std::vector<uint8_t>  seen(grid.size(), 0);
+    std::vector<uint32_t> queue = {from};
+    seen[from]                  = 1;
+    for(size_t idx = 0; idx < queue.size(); idx++) {
+        if(queue[idx] == to) {
+            return true;
+        }
+        for(int dir = 0; dir < neighborhood.size(); dir++) {
+            const uint32_t next = queue[idx] + neighborhood.offset(grid, dir);
+            if(!seen[next] && neighborhood.canMove(grid, queue[idx], next, dir)) {
+                seen[next] = 1;
+                queue.push_back(next);
+            }
+        }
+    }
+    return false;
+}
+
+}    // namespace
+
+TEST(ConnectedComponentsTest, Regions) {
+    Grid grid(5, 3);
+    for(int y = 0; y < 3; y++) {
+        grid.set(2, y, BLOCK);
+    }
+
+    ConnectedComponents<> components;
+    EXPECT_TRUE(components.connected(grid.index(0, 0), grid.index(4, 0)));
+    components.build(grid);
+    EXPECT_TRUE(components.connected(grid.index(0, 0), grid.index(1, 2)));
+    EXPECT_FALSE(components.connected(grid.index(0, 0), grid.index(4, 0)));
+    EXPECT_FALSE(components.connected(grid.index(0, 0), grid.index(2, 0)));
+    EXPECT_TRUE(components.connectedShared(grid.index(0, 0), grid.index(1, 2)));
+    EXPECT_FALSE(components.connectedShared(grid.index(0, 0), grid.index(4, 0)));
+
+    // Opening a door merges both sides, closing it keeps them merged until the next build
+    grid.set(2, 1, EMPTY);
+    components.update(grid, grid.index(2, 1));
+    EXPECT_TRUE(components.connected(grid.index(0, 0), grid.index(4, 0)));
+    EXPECT_TRUE(components.connected(grid.index(2, 1), grid.index(4, 2)));
+    EXPECT_FALSE(components.isStale());
+
+    grid.set(2, 1, BLOCK);
+    components.update(grid, grid.index(2, 1));
+    EXPECT_TRUE(components.isStale());
+    EXPECT_TRUE(components.connected(grid.index(0, 0), grid.index(4, 0)));
+    components.build(grid);
+    EXPECT_FALSE(components.isStale());
+    EXPECT_FALSE(components.connected(grid.index(0, 0), grid.index(4, 0)));
+}
+
+TEST(ConnectedComponentsTest, MatchesSearchAfterEdits) {
+    std::mt19937                       rng(22);
+    std::uniform_int_distribution<int> coord(0, 14);
+    std::bernoulli_distribution        wall(0.45);
+
+    const EightNeighborhood neighborhood{CornerCutting::FORBIDDEN};
+    Grid                    grid(15, 15);
+    for(int y = 0; y < 15; y++) {
+        for(int x = 0; x < 15; x++) {
+            grid.set(x, y, wall(rng) ? BLOCK : EMPTY);
+        }
+    }
+    ConnectedComponents<EightNeighborhood> components(neighborhood);
+    components.build(grid);
+
+    for(int round = 0; round < 300; round++) {
+        const uint32_t cell = grid.index(coord(rng), coord(rng));
+        grid.set(cell, grid.isBlocked(cell) ? EMPTY : BLOCK);
+        components.update(grid, cell);
+        if(round % 50 == 49) {
+            components.build(grid);
+        }
+
+        for(int query = 0; query < 10; query++) {
+            const uint32_t from     = grid.index(coord(rng), coord(rng));
+            const uint32_t to       = grid.index(coord(rng), coord(rng));
+            const bool     expected = reachable(grid, neighborhood, from, to);
+            if(expected) {
+                EXPECT_TRUE(components.connected(from, to));
+            } else if(!components.isStale() && !grid.isBlocked(from)) {
+                EXPECT_FALSE(components.connected(from, to));
+            }
+        }
+    }
+}
+
+TEST(ConnectedComponentsTest, RejectsUnreachableQueries) {
+    PathFinder finder;
+    finder.set({"S.#...", "..#...", "..#..E"});
+    finder.setStatsEnabled(true);
+    for(Strategy strategy : {Strategy::A_STAR, Strategy::JUMP_POINT}) {
+        finder.setStrategy(strategy);
+        EXPECT_TRUE(finder.solve().empty());
+        EXPECT_EQ(finder.stats().expanded, 0);
+    }
+
+    finder.updateCell(2, 1, EMPTY);
+    EXPECT_EQ(finder.solve().size(), 8);
+
+    // The closed door leaves the regions merged, the failed search splits them again
+    finder.updateCell(2, 1, BLOCK);
+    EXPECT_TRUE(finder.solve().empty());
+    EXPECT_GT(finder.stats().expanded, 0);
+    EXPECT_TRUE(finder.solve().empty());
+    EXPECT_EQ(finder.stats().expanded, 0);
+
+    auto results = finder.solveBatch({
+        {{0, 0}, {1, 2}},
+        {{0, 0}, {5, 2}}
+    });
+    EXPECT_EQ(results[0].cost, 3);
+    EXPECT_TRUE(results[1].path.empty());
+    const uint64_t expanded = finder.stats().expanded;
+    finder.solveBatch({
+        {{0, 0}, {1, 2}}
+    });
+    EXPECT_EQ(finder.stats().expanded, expanded);
+
+    // Moving the end next to the start
+    finder.updateCell(1, 1, END);
+    EXPECT_EQ(finder.getMap().at(5, 2), EMPTY);
+    EXPECT_EQ(finder.solve().size(), 3);
+}
+
+TEST(ConnectedComponentsTest, BasicPathFinderEdits) {
+    Grid grid(6, 3);
+    for(int y = 0; y < 3; y++) {
+        grid.set(2, y, BLOCK);
+    }
+    grid.set(0, 0, START);
+    grid.set(5, 2, END);
+
+    OctilePathFinder finder;
+    finder.set(grid);
+    finder.setStatsEnabled(true);
+    EXPECT_TRUE(finder.solve().empty());
+    EXPECT_EQ(finder.stats().expanded, 0);
+
+    finder.updateCell(2, 0, EMPTY);
+    EXPECT_FALSE(finder.solve().empty());
+    finder.updateCell(2, 0, BLOCK);
+    EXPECT_TRUE(finder.solve().empty());
+    EXPECT_TRUE(finder.solve().empty());
+    EXPECT_EQ(finder.stats().expanded, 0);
+}
@@ -0,0 +1,63 @@
+#include <pathfinder/BasicPathFinder.hpp>
+#include <pathfinder/FlowField.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace cam::pathfinder;
+using namespace cam::math;
+
+TEST(FlowFieldTest, FollowsToGoal) {
+    Grid grid(5, 3);
+    grid.set(1, 0, BLOCK);
+    grid.set(1, 1, BLOCK);
+    grid.set(0, 0, END);
+    grid.set(4, 2, BLOCK);
+
+    FlowField<> field;
+    field.build(grid);
+    EXPECT_EQ(field.distance(0, 0), 0);
+    EXPECT_EQ(field.direction(0, 0), FlowField<>::NONE);
+    EXPECT_EQ(field.distance(2, 0), 6);
+    EXPECT_EQ(field.distance(4, 2), FlowField<>::INFINITE);
+    EXPECT_EQ(field.distance(-1, 0), FlowField<>::INFINITE);
+    EXPECT_TRUE(field.path(4, 2).empty());
+
+    auto path = field.path(2, 0);
+    ASSERT_EQ(path.size(), 7);
+    EXPECT_EQ(path.front(), Vector2i(2, 0));
+    EXPECT_EQ(path[3], Vector2i(1, 2));
+    EXPECT_EQ(path.back(), Vector2i(0, 0));
+}
+
+TEST(FlowFieldTest, MatchesSearch) {
+    std::mt19937                       rng(11);
+    std::uniform_int_distribution<int> coord(0, 29);
+    std::bernoulli_distribution        wall(0.3);
+
+    Grid grid(30, 30);
+    for(int y = 0; y < 30; y++) {
+        for(int x = 0; x < 30; x++) {
+            grid.set(x, y, wall(rng) ? BLOCK : EMPTY);
+        }
+    }
+    const Vector2i goal(coord(rng), coord(rng));
+    grid.set(goal.getX(), goal.getY(), EMPTY);
+
+    FlowField<> field;
+    field.build(grid, grid.index(goal.getX(), goal.getY()));
+    QuerySolver solver;
+    for(int y = 0; y < 30; y++) {
+        for(int x = 0; x < 30; x++) {
+            QueryResult expected;
+            solver.solve(grid, Strategy::A_STAR, {{x, y}, goal}, expected);
+            auto path = field.path(x, y);
+            ASSERT_EQ(path.size(), expected.path.size());
+            if(!path.empty()) {
+                EXPECT_EQ(field.distance(x, y), expected.cost);
+                EXPECT_EQ(path.back(), goal);
+            }
+        }
+    }
+}
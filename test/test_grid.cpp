@@ -0,0 +1,73 @@
+#include <pathfinder/Grid.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace cam::pathfinder;
+using namespace cam::math;
+
+TEST(GridTest, FillAndBorder) {
+    Grid grid(4, 3);
+
+    EXPECT_EQ(grid.getWidth(), 4);
+    EXPECT_EQ(grid.getHeight(), 3);
+    EXPECT_EQ(grid.getStride(), 4 + 2 * Grid::BORDER);
+    EXPECT_EQ(grid.size(), (size_t)(4 + 2 * Grid::BORDER) * (3 + 2 * Grid::BORDER));
+    EXPECT_EQ(grid.at(0, 0), EMPTY);
+    EXPECT_EQ(grid.at(3, 2), EMPTY);
+
+    // The frame around the map is blocked, so neighbors of edge cells can be read without bounds checks
+    EXPECT_TRUE(grid.isBlocked(grid.index(-1, 0)));
+    EXPECT_TRUE(grid.isBlocked(grid.index(4, 2)));
+    EXPECT_TRUE(grid.isBlocked(grid.index(0, 0) + grid.offset(0, -1)));
+    EXPECT_TRUE(grid.isBlocked(grid.index(3, 2) + grid.offset(0, 1)));
+}
+
+TEST(GridTest, IndexAndPosition) {
+    Grid grid(5, 5);
+
+    for(int y = 0; y < 5; y++) {
+        for(int x = 0; x < 5; x++) {
+            EXPECT_EQ(grid.position(grid.index(x, y)), Vector2i(x, y));
+        }
+    }
+    EXPECT_EQ(grid.index(2, 2) + grid.offset(1, 0), grid.index(3, 2));
+    EXPECT_EQ(grid.index(2, 2) + grid.offset(0, -1), grid.index(2, 1));
+    EXPECT_TRUE(grid.inside(4, 4));
+    EXPECT_FALSE(grid.inside(5, 0));
+    EXPECT_FALSE(grid.inside(0, -1));
+}
+
+TEST(GridTest, SetAndFind) {
+    Grid grid(3, 3);
+
+    EXPECT_EQ(grid.find(START), 0);
+    grid.set(1, 2, START);
+    grid.set(2, 0, BLOCK);
+
+    EXPECT_EQ(grid.find(START), grid.index(1, 2));
+    EXPECT_EQ(grid.at(1, 2), START);
+    EXPECT_TRUE(grid.isBlocked(grid.index(2, 0)));
+    EXPECT_FALSE(grid.isBlocked(grid.index(1, 2)));
+}
+
+TEST(GridTest, Weights) {
+    Grid grid(3, 2);
+    EXPECT_FALSE(grid.isWeighted());
+    EXPECT_EQ(grid.weight(1, 1), 1);
+
+    grid.setWeight(1, 1, 7);
+    grid.set(1, 1, START);
+    EXPECT_TRUE(grid.isWeighted());
+    EXPECT_EQ(grid.weight(1, 1), 7);
+    EXPECT_EQ(grid.at(1, 1), START);
+    EXPECT_EQ(grid.find(START), grid.index(1, 1));
+
+    grid.set(1, 1, BLOCK);
+    EXPECT_TRUE(grid.isBlocked(grid.index(1, 1)));
+    EXPECT_EQ(grid.weight(1, 1), 7);
+
+    grid.setWeight(0, 0, 1000);
+    EXPECT_EQ(grid.weight(0, 0), Grid::MAX_WEIGHT);
+    grid.setWeight(0, 0, 0);
+    EXPECT_EQ(grid.weight(0, 0), 1);
+}
@@ -0,0 +1,126 @@
+#include <pathfinder/BasicPathFinder.hpp>
+#include <pathfinder/HierarchicalPathFinder.hpp>
+
+#include "TestMaps.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace cam::pathfinder;
+using namespace cam::math;
+
+namespace {
+
+void
+expectValidPath(const Grid &grid, const std::vector<Vector2i> &path, Vector2i start, Vector2i end) {
+    ASSERT_FALSE(path.empty());
+    EXPECT_EQ(path.front(), start);
+    EXPECT_EQ(path.back(), end);
+    for(size_t idx = 1; idx < path.size(); idx++) {
+        EXPECT_EQ(std::abs(path[idx].getX() - path[idx - 1].getX()) + std::abs(path[idx].getY() - path[idx - 1].getY()), 1);
+        EXPECT_FALSE(grid.isBlocked(grid.index(path[idx].getX(), path[idx].getY())));
+    }
+}
+
+}    // namespace
+
+TEST(HierarchicalPathFinderTest, OpenMapIsOptimal) {
+    Grid grid(50, 30);
+    grid.set(2, 3, START);
+    grid.set(47, 28, END);
+
+    HierarchicalPathFinder pathFinder(8);
+    pathFinder.set(grid);
+    EXPECT_EQ(pathFinder.clusterCount(), 7 * 4);
+
+    auto path = pathFinder.solve();
+    expectValidPath(grid, path, {2, 3}, {47, 28});
+    EXPECT_EQ(pathFinder.cost(), 45 + 25);
+    EXPECT_EQ(path.size(), 45 + 25 + 1);
+}
+
+TEST(HierarchicalPathFinderTest, MatchesReachability) {
+    std::mt19937                       rng(3);
+    std::uniform_int_distribution<int> coord(0, 63);
+    std::bernoulli_distribution        wall(0.25);
+
+    Grid grid(64, 64);
+    for(int y = 0; y < 64; y++) {
+        for(int x = 0; x < 64; x++) {
+            grid.set(x, y, wall(rng) ? BLOCK : EMPTY);
+        }
+    }
+
+    HierarchicalPathFinder pathFinder(10);
+    pathFinder.set(grid);
+    QuerySolver solver;
+    for(int query = 0; query < 200; query++) {
+        Query       q = {{coord(rng), coord(rng)}, {coord(rng), coord(rng)}};
+        QueryResult result;
+        QueryResult expected;
+        pathFinder.solve(q, result);
+        solver.solve(grid, Strategy::A_STAR, q, expected);
+
+        ASSERT_EQ(result.path.empty(), expected.path.empty());
+        if(!result.path.empty()) {
+            expectValidPath(grid, result.path, q.first, q.second);
+            EXPECT_EQ(result.cost, result.path.size() - 1);
+            EXPECT_GE(result.cost, expected.cost);
+        }
+    }
+}
+
+TEST(HierarchicalPathFinderTest, WeightedMapsCostTerrain) {
+    for(uint32_t seed = 1; seed <= 10; seed++) {
+        PathFinder astar;
+        astar.set(testmaps::randomMap(64, 20, seed));
+        astar.solve();
+        const Grid &grid = astar.getMap();
+
+        HierarchicalPathFinder pathFinder(8);
+        pathFinder.set(grid);
+        auto path = pathFinder.solve();
+        expectValidPath(grid, path, {0, 0}, {63, 63});
+
+        int weights = 0;
+        for(size_t idx = 1; idx < path.size(); idx++) {
+            weights += grid.weight(path[idx].getX(), path[idx].getY());
+        }
+        EXPECT_EQ(pathFinder.cost(), weights);
+        EXPECT_GE(pathFinder.cost(), astar.cost());
+    }
+}
+
+TEST(HierarchicalPathFinderTest, EditsInvalidateTouchedClusters) {
+    Grid grid(40, 40);
+    grid.set(0, 0, START);
+    grid.set(39, 39, END);
+
+    HierarchicalPathFinder pathFinder(10);
+    pathFinder.set(grid);
+    EXPECT_EQ(pathFinder.rebuiltClusters(), 16);
+    EXPECT_EQ(pathFinder.solve().size(), 79);
+    EXPECT_EQ(pathFinder.rebuiltClusters(), 0);
+
+    // Inside a cluster
+    pathFinder.updateCell(5, 5, BLOCK);
+    pathFinder.solve();
+    EXPECT_EQ(pathFinder.rebuiltClusters(), 1);
+
+    // On the border between two clusters
+    pathFinder.updateCell(9, 15, BLOCK);
+    pathFinder.solve();
+    EXPECT_EQ(pathFinder.rebuiltClusters(), 2);
+
+    // Wall across the whole map
+    for(int x = 0; x < 40; x++) {
+        pathFinder.updateCell(x, 20, BLOCK);
+    }
+    EXPECT_TRUE(pathFinder.solve().empty());
+    EXPECT_EQ(pathFinder.cost(), HierarchicalPathFinder::INFINITE);
+
+    pathFinder.updateCell(33, 20, EMPTY);
+    auto path = pathFinder.solve();
+    expectValidPath(pathFinder.getMap(), path, {0, 0}, {39, 39});
+}
@@ -0,0 +1,86 @@
+#include <pathfinder/BasicPathFinder.hpp>
+#include <pathfinder/IncrementalPathFinder.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace cam::pathfinder;
+using namespace cam::math;
+
+TEST(IncrementalPathFinderTest, RepairsAfterEdits) {
+    Grid grid(6, 4);
+    grid.set(0, 0, START);
+    grid.set(5, 3, END);
+
+    IncrementalPathFinder<> pathFinder;
+    pathFinder.set(grid);
+    EXPECT_EQ(pathFinder.solve().size(), 9);
+    EXPECT_EQ(pathFinder.cost(), 8);
+
+    // Wall with a single gap at the bottom
+    for(int y = 0; y < 3; y++) {
+        pathFinder.updateCell(3, y, BLOCK);
+    }
+    auto path = pathFinder.solve();
+    ASSERT_EQ(path.size(), 9);
+    EXPECT_EQ(path.front(), Vector2i(0, 0));
+    EXPECT_EQ(path.back(), Vector2i(5, 3));
+
+    pathFinder.updateCell(3, 3, BLOCK);
+    EXPECT_TRUE(pathFinder.solve().empty());
+    EXPECT_EQ(pathFinder.cost(), IncrementalPathFinder<>::INFINITE);
+
+    pathFinder.updateCell(3, 0, EMPTY);
+    EXPECT_EQ(pathFinder.solve().size(), 9);
+
+    pathFinder.updateCell(4, 0, START);
+    EXPECT_EQ(pathFinder.solve().size(), 5);
+    EXPECT_EQ(pathFinder.getMap().at(0, 0), EMPTY);
+}
+
+TEST(IncrementalPathFinderTest, MatchesFullSearch) {
+    std::mt19937                       rng(7);
+    std::uniform_int_distribution<int> coord(0, 39);
+    std::bernoulli_distribution        wall(0.3);
+
+    Grid grid(40, 40);
+    for(int y = 0; y < 40; y++) {
+        for(int x = 0; x < 40; x++) {
+            grid.set(x, y, wall(rng) ? BLOCK : EMPTY);
+        }
+    }
+    grid.set(0, 0, START);
+    grid.set(39, 39, END);
+
+    IncrementalPathFinder<> pathFinder;
+    pathFinder.set(grid);
+    pathFinder.solve();
+    const size_t initial = pathFinder.expansions();
+
+    for(int edit = 0; edit < 200; edit++) {
+        const int x = coord(rng);
+        const int y = coord(rng);
+        const Type type = pathFinder.getMap().at(x, y);
+        if(type == START || type == END) {
+            continue;
+        }
+        pathFinder.updateCell(x, y, type == BLOCK ? EMPTY : BLOCK);
+
+        auto            path = pathFinder.solve();
+        BasicPathFinder<> reference;
+        reference.set(pathFinder.getMap());
+        auto expected = reference.solve();
+        ASSERT_EQ(path.size(), expected.size());
+        EXPECT_EQ(pathFinder.cost(), reference.cost());
+        for(size_t idx = 1; idx < path.size(); idx++) {
+            EXPECT_EQ(std::abs(path[idx].getX() - path[idx - 1].getX()) + std::abs(path[idx].getY() - path[idx - 1].getY()), 1);
+            EXPECT_FALSE(pathFinder.getMap().isBlocked(pathFinder.getMap().index(path[idx].getX(), path[idx].getY())));
+        }
+    }
+
+    // A change far from every path costs nothing to repair
+    pathFinder.updateCell(39, 0, pathFinder.getMap().at(39, 0) == BLOCK ? EMPTY : BLOCK);
+    pathFinder.solve();
+    EXPECT_LT(pathFinder.expansions(), initial);
+}
@@ -0,0 +1,64 @@
+#include <pathfinder/IndexedHeap.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace cam::pathfinder;
+
+TEST(IndexedHeapTest, PopsInOrder) {
+    std::mt19937          rng(7);
+    IndexedHeap<int, 3>   heap;
+    std::vector<int>      values(200);
+    heap.reset(values.size());
+    for(size_t key = 0; key < values.size(); key++) {
+        values[key] = rng() % 1000;
+        EXPECT_TRUE(heap.push(key, values[key]));
+    }
+    std::sort(values.begin(), values.end());
+
+    EXPECT_EQ(heap.size(), values.size());
+    for(int value : values) {
+        EXPECT_EQ(heap.top(), value);
+        EXPECT_EQ(heap.pop(), value);
+    }
+    EXPECT_TRUE(heap.empty());
+}
+
+TEST(IndexedHeapTest, DecreaseKey) {
+    IndexedHeap<int> heap;
+    heap.reset(4);
+    heap.push(0, 10);
+    heap.push(1, 20);
+    heap.push(2, 30);
+
+    EXPECT_FALSE(heap.push(2, 40));
+    EXPECT_EQ(heap.get(2), 30);
+    EXPECT_TRUE(heap.push(2, 5));
+    EXPECT_EQ(heap.size(), 3);
+    EXPECT_EQ(heap.pop(), 5);
+    EXPECT_FALSE(heap.contains(2));
+    EXPECT_TRUE(heap.contains(1));
+
+    heap.reset(4);
+    EXPECT_TRUE(heap.empty());
+    EXPECT_FALSE(heap.contains(0));
+}
+
+TEST(IndexedHeapTest, Remove) {
+    IndexedHeap<int> heap;
+    heap.reset(6);
+    for(int key = 0; key < 6; key++) {
+        heap.push(key, 10 - key);
+    }
+
+    heap.remove(5);
+    heap.remove(2);
+    heap.remove(2);
+    EXPECT_EQ(heap.size(), 4);
+    EXPECT_FALSE(heap.contains(2));
+
+    for(int value : {6, 7, 9, 10}) {
+        EXPECT_EQ(heap.pop(), value);
+    }
+}
@@ -0,0 +1,95 @@
+#include <pathfinder/BasicPathFinder.hpp>
+#include <pathfinder/Landmarks.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+
+using namespace cam::pathfinder;
+using namespace cam::math;
+
+namespace {
+
+// Rows of walls with the gap alternating at both ends, so the only path zigzags through the whole map
+Grid
+serpentine(int size) {
+    Grid grid(size, size);
+    for(int y = 1; y < size; y += 2) {
+        for(int x = 0; x < size; x++) {
+            grid.set(x, y, BLOCK);
+        }
+        grid.set(y % 4 == 1 ? size - 1 : 0, y, EMPTY);
+    }
+    return grid;
+}
+
+}    // namespace
+
+TEST(LandmarksTest, AdmissibleAndTighter) {
+    Grid grid = serpentine(21);
+    auto landmarks = std::make_shared<const Landmarks<int>>(grid, 4, 1 << 20);
+    ASSERT_EQ(landmarks->size(), 4);
+    EXPECT_EQ(landmarks->bytes(), grid.size() * 4 * sizeof(uint16_t));
+
+    LandmarkHeuristic<Landmarks<int>> heuristic{landmarks};
+    QuerySolver                       solver;
+    const uint32_t                    goal  = grid.index(0, 20);
+    size_t                            tight = 0;
+    for(int y = 0; y < 21; y++) {
+        for(int x = 0; x < 21; x++) {
+            const uint32_t cell = grid.index(x, y);
+            int            cost;
+            if(grid.isBlocked(cell) || solver.search(grid, Strategy::A_STAR, cell, goal, cost) == nullptr) {
+                continue;
+            }
+            const int estimation = heuristic(grid, cell, goal);
+            EXPECT_LE(estimation, cost);
+            EXPECT_GE(estimation, std::abs(x) + std::abs(y - 20));
+            tight += estimation == cost;
+        }
+    }
+    // The serpentine has a single path, so the landmarks at its ends give the exact cost almost everywhere
+    EXPECT_GT(tight, 200);
+}
+
+TEST(LandmarksTest, Budget) {
+    Grid grid(30, 30);
+    EXPECT_EQ(Landmarks<int>(grid, 8, grid.size() * 2 * 3).size(), 3);
+    EXPECT_EQ(Landmarks<int>(grid, 8, 0).size(), 0);
+    EXPECT_EQ((Landmarks<int, uint32_t>(grid, 8, grid.size() * 4 * 3).size()), 3);
+}
+
+TEST(LandmarksTest, SameSolutionAsManhattan) {
+    std::mt19937                       rng(5);
+    std::uniform_int_distribution<int> coord(0, 39);
+    std::bernoulli_distribution        wall(0.3);
+
+    Grid grid(40, 40);
+    for(int y = 0; y < 40; y++) {
+        for(int x = 0; x < 40; x++) {
+            grid.set(x, y, wall(rng) ? BLOCK : EMPTY);
+        }
+    }
+
+    using Heuristic = LandmarkHeuristic<Landmarks<int>>;
+    BasicPathFinder<>                                             reference;
+    BasicPathFinder<Grid, FourNeighborhood, UnitCost, Heuristic> pathFinder({}, {}, {std::make_shared<const Landmarks<int>>(grid, 6, 1 << 20)});
+    reference.set(grid);
+    pathFinder.set(grid);
+
+    std::vector<Query> queries;
+    for(int idx = 0; idx < 100; idx++) {
+        queries.push_back({{coord(rng), coord(rng)}, {coord(rng), coord(rng)}});
+    }
+    for(auto strategy : {Strategy::A_STAR, Strategy::BIDIRECTIONAL}) {
+        reference.setStrategy(strategy);
+        pathFinder.setStrategy(strategy);
+        auto expected = reference.solveBatch(queries);
+        auto results  = pathFinder.solveBatch(queries);
+        for(size_t idx = 0; idx < queries.size(); idx++) {
+            EXPECT_EQ(results[idx].path.size(), expected[idx].path.size());
+            EXPECT_EQ(results[idx].cost, expected[idx].cost);
+        }
+    }
+}
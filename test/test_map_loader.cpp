@@ -0,0 +1,101 @@
+#include <pathfinder/MapLoader.hpp>
+#include <pathfinder/PathFinder.hpp>
+#include <util/FileUtil.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+
+using namespace cam::pathfinder;
+using namespace cam::math;
+using namespace cam::util;
+
+#ifdef _WIN32
+#    define BASE_PATH "c:"
+#else
+#    define BASE_PATH
+#endif
+
+TEST(MapLoaderTest, ParseBuffer) {
+    const char *text = "S.#3\r\n..\r\n#.E.x\r\n";
+    LoadedMap   map;
+    ASSERT_TRUE(MapLoader::parse(text, std::strlen(text), map));
+
+    EXPECT_EQ(map.grid.getWidth(), 4);
+    EXPECT_EQ(map.grid.getHeight(), 3);
+    EXPECT_EQ(map.start, map.grid.index(0, 0));
+    EXPECT_EQ(map.end, map.grid.index(2, 2));
+    EXPECT_EQ(map.grid.at(2, 0), BLOCK);
+    EXPECT_EQ(map.grid.at(3, 0), EMPTY);
+    EXPECT_EQ(map.grid.weight(3, 0), 3);
+    // Short rows are padded with walls, long ones cut
+    EXPECT_EQ(map.grid.at(1, 1), EMPTY);
+    EXPECT_EQ(map.grid.at(2, 1), BLOCK);
+    EXPECT_EQ(map.grid.at(3, 2), EMPTY);
+
+    EXPECT_FALSE(MapLoader::parse("", 0, map));
+    EXPECT_FALSE(MapLoader::parse("\n..", 3, map));
+}
+
+TEST(MapLoaderTest, LoadFileMatchesParse) {
+    const char              *path = BASE_PATH "/tmp/toolit_map.txt";
+    std::vector<std::string> data = {"S...#.....", ".##.#.###.", ".#..#...#.", ".#.####.#.", "........#E"};
+    std::string              content;
+    for(const auto &row : data) {
+        content += row + "\n";
+    }
+    ASSERT_TRUE(FileUtil::fileWrite(path, content));
+
+    PathFinder expected;
+    PathFinder loaded;
+    expected.set(data);
+    ASSERT_TRUE(loaded.load(path));
+    ASSERT_TRUE(FileUtil::fileRemove(path));
+    EXPECT_FALSE(loaded.load(path));
+
+    EXPECT_EQ(loaded.getMap().getWidth(), 10);
+    EXPECT_EQ(loaded.getMap().getHeight(), 5);
+    auto solution = loaded.solve();
+    EXPECT_EQ(solution, expected.solve());
+    EXPECT_EQ(loaded.cost(), expected.cost());
+}
+
+TEST(MapLoaderTest, ParseRowMatchesCellType) {
+    std::mt19937                       rng(23);
+    std::uniform_int_distribution<int> common(0, 15);
+    std::uniform_int_distribution<int> any(0, 255);
+    const char                         ALPHABET[] = "....####SE123999";
+
+    for(int round = 0; round < 50; round++) {
+        // Long enough for several vector blocks and a scalar tail, cut at the width of the grid
+        std::string row(70 + round % 40, '.');
+        for(char &c : row) {
+            c = round % 2 == 0 ? ALPHABET[common(rng)] : (char)any(rng);
+        }
+
+        Grid     grid(100, 2, BLOCK);
+        uint32_t start = round % 3 == 0 ? 7 : 0;
+        uint32_t end   = 0;
+        MapLoader::parseRow(grid, 1, row.data(), row.size(), start, end);
+
+        uint32_t expectedStart = round % 3 == 0 ? 7 : 0;
+        uint32_t expectedEnd   = 0;
+        bool     weighted      = false;
+        for(int x = 0; x < 100; x++) {
+            int        weight = 1;
+            const Type type   = x < (int)row.size() ? MapLoader::cellType(row[x], weight) : BLOCK;
+            ASSERT_EQ(grid.at(x, 1), type) << "column " << x << " char " << (int)row[x];
+            ASSERT_EQ(grid.weight(x, 1), weight) << "column " << x;
+            weighted |= weight > 1;
+            if(type == START && expectedStart == 0) {
+                expectedStart = grid.index(x, 1);
+            } else if(type == END && expectedEnd == 0) {
+                expectedEnd = grid.index(x, 1);
+            }
+        }
+        EXPECT_EQ(start, expectedStart);
+        EXPECT_EQ(end, expectedEnd);
+        EXPECT_EQ(grid.isWeighted(), weighted);
+    }
+}
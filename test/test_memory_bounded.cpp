@@ -0,0 +1,221 @@
+#include <pathfinder/BasicPathFinder.hpp>
+#include <pathfinder/PathFinder.hpp>
+
+#include <gtest/gtest.h>
+
+#include <tuple>
+
+#include "TestMaps.hpp"
+
+using namespace cam::pathfinder;
+using namespace cam::math;
+using namespace testmaps;
+
+namespace {
+
+void
+expectConnected(const std::vector<Vector2> &path, const Vector2 &from, const Vector2 &to) {
+    ASSERT_FALSE(path.empty());
+    EXPECT_EQ(path.front(), from);
+    EXPECT_EQ(path.back(), to);
+    for(size_t idx = 1; idx < path.size(); idx++) {
+        EXPECT_EQ(path[idx - 1].distance(path[idx], MANHATTAN), 1.0);
+    }
+}
+
+}    // namespace
+
+TEST(MemoryBoundedTest, MatchesAStarCost) {
+    for(uint32_t seed = 1; seed <= 10; seed++) {
+        const auto data = randomMap(12, 25, seed);
+
+        PathFinder astar;
+        astar.set(data);
+        astar.solve();
+
+        for(Strategy strategy : {Strategy::ITERATIVE_DEEPENING, Strategy::MEMORY_BOUNDED}) {
+            PathFinder       finder;
+            HookedPathFinder hooked;
+            finder.set(data);
+            hooked.set(data);
+            finder.setStrategy(strategy);
+            hooked.setStrategy(strategy);
+            finder.setMemoryBudget(1 << 20);
+            hooked.setMemoryBudget(1 << 20);
+            finder.setStatsEnabled(true);
+
+            // The hook may charge for turns, so its nodes are told apart by direction and ties can end on another path
+            auto solution = finder.solve();
+            EXPECT_EQ(finder.stats().budgetHits, 0);
+            expectConnected(solution, Vector2(0, 0), Vector2(11, 11));
+            expectConnected(hooked.solve(), Vector2(0, 0), Vector2(11, 11));
+            EXPECT_EQ(finder.cost(), astar.cost());
+            EXPECT_EQ(hooked.cost(), astar.cost());
+            EXPECT_EQ(finder.alternatives().size(), astar.alternatives().size());
+        }
+    }
+}
+
+TEST(MemoryBoundedTest, StaysWithinBudget) {
+    const auto data   = randomMap(48, 20, 7);
+    const auto budget = 64 << 10;
+
+    PathFinder astar;
+    astar.set(data);
+    astar.setStatsEnabled(true);
+    ASSERT_FALSE(astar.solve().empty());
+    ASSERT_GT(astar.stats().bytes, budget);
+
+    for(Strategy strategy : {Strategy::ITERATIVE_DEEPENING, Strategy::MEMORY_BOUNDED}) {
+        PathFinder finder;
+        finder.set(data);
+        finder.setStrategy(strategy);
+        finder.setMemoryBudget(budget);
+        finder.setStatsEnabled(true);
+
+        auto solution = finder.solve();
+        EXPECT_LE(finder.stats().bytes, budget);
+        EXPECT_GT(finder.stats().bytes, budget / 2);
+        expectConnected(solution, Vector2(0, 0), Vector2(47, 47));
+        EXPECT_GE(finder.cost(), astar.cost());
+
+        // Far too small for the path, the search gives up and says why
+        finder.setMemoryBudget(256);
+        EXPECT_TRUE(finder.solve().empty());
+        EXPECT_EQ(finder.stats().budgetHits, 1);
+        EXPECT_LE(finder.stats().bytes, 256);
+
+        // Hitting the bound is counted per query
+        finder.solveBatch({{{0, 0}, {47, 47}}, {{0, 0}, {1, 0}}, {{0, 0}, {47, 47}}});
+        EXPECT_EQ(finder.stats().budgetHits, 2);
+    }
+}
+
+TEST(MemoryBoundedTest, EvictsWorstNodes) {
+    const auto data = randomMap(48, 20, 7);
+
+    PathFinder astar;
+    astar.set(data);
+    astar.solve();
+
+    // The pool holds a fraction of the nodes A* keeps, but enough for the path and its neighbors: the search forgets
+    // and regenerates branches, and still finds an optimal path
+    PathFinder finder;
+    finder.set(data);
+    finder.setStrategy(Strategy::MEMORY_BOUNDED);
+    finder.setMemoryBudget(64 << 10);
+    finder.setStatsEnabled(true);
+    auto solution = finder.solve();
+    expectConnected(solution, Vector2(0, 0), Vector2(47, 47));
+    EXPECT_EQ(finder.stats().budgetHits, 1);
+    EXPECT_EQ(finder.cost(), astar.cost());
+}
+
+TEST(MemoryBoundedTest, GivesUpOnDeepPaths) {
+    // A single corridor winding through the whole map, far longer than the budget allows: no branch can reach the end,
+    // and the searches give up instead of trying them forever
+    std::vector<std::string> maze(15, std::string(15, '.'));
+    for(int y = 1; y < 15; y += 2) {
+        maze[y].assign(15, '#');
+        maze[y][y % 4 == 1 ? 14 : 0] = '.';
+    }
+    maze.front().front() = 'S';
+    maze.back().back()   = 'E';
+
+    // Heavier terrain and dead ends, with budgets around the size of the path
+    const std::vector<std::string> data = {"225....9217", ".9.S.#.#8.#", "932.59.41..", "64..983...5", ".4##..#.#..", "693..#.#.#.",
+                                           ".#.....#.#.", "......#..#5", "7..5..2#.E.", "......2..82", ".8...#.2#.."};
+
+    // Open maps whose path is a little longer than the budget allows, where the paths that fit are countless
+    const std::vector<std::tuple<Strategy, std::vector<std::string>, size_t>> open = {
+        {Strategy::MEMORY_BOUNDED, randomMap(33, 17, 27), 12 << 10},
+        {Strategy::MEMORY_BOUNDED, randomMap(33, 17, 27), 16 << 10},
+        {Strategy::ITERATIVE_DEEPENING, randomMap(13, 7, 7), 1 << 10},
+    };
+
+    for(Strategy strategy : {Strategy::ITERATIVE_DEEPENING, Strategy::MEMORY_BOUNDED}) {
+        PathFinder astar;
+        astar.set(maze);
+        const auto solution = astar.solve();
+
+        PathFinder finder;
+        finder.set(maze);
+        finder.setStrategy(strategy);
+        finder.setMemoryBudget(2 << 10);
+        finder.setStatsEnabled(true);
+        EXPECT_TRUE(finder.solve().empty());
+        EXPECT_EQ(finder.stats().budgetHits, 1);
+        EXPECT_LE(finder.stats().bytes, 2 << 10);
+
+        finder.setMemoryBudget(64 << 10);
+        EXPECT_EQ(finder.solve(), solution);
+        EXPECT_EQ(finder.stats().budgetHits, 0);
+
+        astar.set(data);
+        astar.solve();
+        finder.set(data);
+        for(size_t budget : {1000, 1500, 2000, 2423, 4096, 8192}) {
+            finder.setMemoryBudget(budget);
+            if(finder.solve().empty()) {
+                EXPECT_EQ(finder.stats().budgetHits, 1);
+            } else {
+                EXPECT_GE(finder.cost(), astar.cost());
+            }
+            EXPECT_LE(finder.stats().bytes, budget);
+        }
+    }
+
+    for(const auto &[strategy, rows, budget] : open) {
+        PathFinder finder;
+        finder.set(rows);
+        finder.setStrategy(strategy);
+        finder.setMemoryBudget(budget);
+        finder.setStatsEnabled(true);
+        EXPECT_TRUE(finder.solve().empty());
+        EXPECT_EQ(finder.stats().budgetHits, 1);
+    }
+}
+
+TEST(MemoryBoundedTest, CountsEveryBuffer) {
+    const auto data = randomMap(16, 20, 3);
+
+    PathFinder finder;
+    finder.set(data);
+    finder.setStrategy(Strategy::MEMORY_BOUNDED);
+    finder.setStatsEnabled(true);
+    for(size_t budget = 0; budget < 4096; budget += 47) {
+        finder.setMemoryBudget(budget);
+        finder.solve();
+        EXPECT_LE(finder.stats().bytes, budget);
+    }
+
+    // The path of a query whose start is its goal needs a cell
+    for(size_t budget : {0, 3, 94}) {
+        finder.setMemoryBudget(budget);
+        finder.solveBatch({{{5, 5}, {5, 5}}});
+        EXPECT_LE(finder.stats().bytes, budget);
+    }
+}
+
+TEST(MemoryBoundedTest, BasicPathFinder) {
+    Grid grid(24, 24);
+    for(int y = 2; y < 22; y++) {
+        grid.set(12, y, BLOCK);
+        grid.set(y, 12, y == 6 ? EMPTY : BLOCK);
+    }
+    grid.set(0, 0, START);
+    grid.set(23, 23, END);
+
+    OctilePathFinder astar;
+    astar.set(grid);
+    astar.solve();
+
+    for(Strategy strategy : {Strategy::ITERATIVE_DEEPENING, Strategy::MEMORY_BOUNDED}) {
+        OctilePathFinder finder;
+        finder.set(grid);
+        finder.setStrategy(strategy);
+        finder.setMemoryBudget(1 << 20);
+        EXPECT_FALSE(finder.solve().empty());
+        EXPECT_EQ(finder.cost(), astar.cost());
+    }
+}
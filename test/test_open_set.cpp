@@ -0,0 +1,80 @@
+#include <pathfinder/BucketQueue.hpp>
+#include <pathfinder/OpenSet.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace cam::pathfinder;
+
+namespace {
+
+struct Item {
+    double f;
+
+    bool
+    operator>(const Item &other) const {
+        return f > other.f;
+    }
+};
+
+}    // namespace
+
+TEST(BucketQueueTest, PopsInOrderAcrossGrowth) {
+    std::mt19937        rng(11);
+    BucketQueue<Item>   queue;
+    std::vector<double> values(300);
+    queue.reset(values.size());
+    for(size_t key = 0; key < values.size(); key++) {
+        values[key] = rng() % 1000;
+        ASSERT_TRUE(queue.fits({values[key]}));
+        queue.push(key, {values[key]});
+    }
+    std::sort(values.begin(), values.end());
+
+    for(double value : values) {
+        EXPECT_EQ(queue.top().f, value);
+        EXPECT_EQ(queue.pop().f, value);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(BucketQueueTest, DecreaseKeyAndFits) {
+    BucketQueue<Item> queue;
+    queue.reset(3);
+    EXPECT_FALSE(queue.fits({0.5}));
+
+    queue.push(0, {10});
+    queue.push(1, {12});
+    EXPECT_FALSE(queue.push(1, {13}));
+    EXPECT_TRUE(queue.push(1, {4}));
+    EXPECT_EQ(queue.size(), 2);
+    EXPECT_EQ(queue.get(1).f, 4);
+    EXPECT_FALSE(queue.fits({10 + BucketQueue<Item>::MAX_SPAN}));
+
+    EXPECT_EQ(queue.pop().f, 4);
+    EXPECT_FALSE(queue.contains(1));
+    EXPECT_TRUE(queue.contains(0));
+}
+
+TEST(OpenSetTest, FallsBackToHeap) {
+    OpenSet<Item> open;
+    open.reset(4);
+    open.push(0, {3});
+    open.push(1, {1});
+    EXPECT_TRUE(open.isBucketed());
+
+    open.push(2, {2.5});
+    EXPECT_FALSE(open.isBucketed());
+    EXPECT_TRUE(open.contains(0));
+    EXPECT_TRUE(open.push(0, {0.5}));
+    EXPECT_EQ(open.size(), 3);
+
+    EXPECT_EQ(open.pop().f, 0.5);
+    EXPECT_EQ(open.pop().f, 1);
+    EXPECT_EQ(open.pop().f, 2.5);
+    EXPECT_TRUE(open.empty());
+
+    open.reset(4);
+    EXPECT_TRUE(open.isBucketed());
+}
@@ -0,0 +1,67 @@
+#include <pathfinder/ParallelPathFinder.hpp>
+#include <pathfinder/PathFinder.hpp>
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <memory>
+
+using namespace cam::pathfinder;
+using namespace cam::math;
+
+TEST(ParallelPathFinderTest, MatchesSequentialBatch) {
+    std::vector<std::string> data = {"S...#.....", ".##.#.###.", ".#..#...#.", ".#.####.#.", "........#E"};
+
+    PathFinder pathFinder;
+    pathFinder.set(data);
+
+    std::vector<Query> queries;
+    for(int y = 0; y < 5; y++) {
+        for(int x = 0; x < 10; x++) {
+            queries.push_back({{x, y}, {9 - x, 4 - y}});
+        }
+    }
+
+    for(auto strategy : {Strategy::A_STAR, Strategy::JUMP_POINT, Strategy::BIDIRECTIONAL}) {
+        pathFinder.setStrategy(strategy);
+        auto expected = pathFinder.solveBatch(queries);
+
+        ParallelPathFinder parallel(std::make_shared<const Grid>(pathFinder.getMap()), 4);
+        parallel.setStrategy(strategy);
+        EXPECT_EQ(parallel.threadCount(), 4);
+
+        std::vector<QueryResult> results;
+        for(int round = 0; round < 3; round++) {
+            parallel.solveBatch(queries, results);
+            ASSERT_EQ(results.size(), queries.size());
+            for(size_t idx = 0; idx < queries.size(); idx++) {
+                EXPECT_EQ(results[idx].cost, expected[idx].cost);
+                EXPECT_EQ(results[idx].path.size(), expected[idx].path.size());
+            }
+        }
+    }
+}
+
+TEST(ParallelPathFinderTest, RejectsDisconnectedQueries) {
+    PathFinder pathFinder;
+    pathFinder.set({"S.#...", "..#...", "..#..E"});
+
+    ParallelPathFinder parallel(std::make_shared<const Grid>(pathFinder.getMap()), 2);
+    const std::vector<Query> queries = {{{0, 0}, {5, 2}}, {{0, 0}, {1, 2}}, {{5, 0}, {0, 2}}, {{0, 0}, {2, 1}}, {{0, 0}, {9, 9}}};
+    for(auto strategy : {Strategy::A_STAR, Strategy::BIDIRECTIONAL}) {
+        parallel.setStrategy(strategy);
+        auto results = parallel.solveBatch(queries);
+        EXPECT_EQ(results[1].cost, 3);
+        EXPECT_EQ(results[1].path.size(), 4);
+        for(size_t idx : {0, 2, 3, 4}) {
+            EXPECT_TRUE(results[idx].path.empty());
+            EXPECT_EQ(results[idx].cost, std::numeric_limits<double>::max());
+        }
+    }
+}
+
+TEST(ParallelPathFinderTest, EmptyBatch) {
+    ParallelPathFinder parallel(std::make_shared<const Grid>(3, 3));
+    EXPECT_GE(parallel.threadCount(), 1);
+    EXPECT_TRUE(parallel.solveBatch({}).empty());
+}
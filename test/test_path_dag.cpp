@@ -0,0 +1,57 @@
+#include <pathfinder/PathDag.hpp>
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+using namespace cam::pathfinder;
+
+// Diamond with two paths from cell 1 to cell 4, plus a cell off every path
+static PathDag
+diamond() {
+    PathDag dag;
+    dag.reset(6, 4);
+
+    dag.open(0);
+    const uint32_t left  = dag.add(2);
+    const uint32_t right = dag.add(3);
+    dag.link(left);
+    dag.link(right);
+
+    const uint32_t start = dag.add(1);
+    dag.open(left);
+    dag.link(start);
+    dag.open(right);
+    dag.link(start);
+    dag.open(start);
+    dag.finish();
+    return dag;
+}
+
+TEST(PathDagTest, CountsAndEnumerates) {
+    PathDag dag = diamond();
+
+    EXPECT_EQ(dag.count(), 2);
+    EXPECT_EQ(dag.size(), 4);
+
+    std::vector<PathDag::Path> paths(dag.begin(), dag.end());
+    ASSERT_EQ(paths.size(), 2);
+    EXPECT_EQ(paths[0], PathDag::Path({1, 2, 4}));
+    EXPECT_EQ(paths[1], PathDag::Path({1, 3, 4}));
+
+    EXPECT_TRUE(dag.onPath(1));
+    EXPECT_TRUE(dag.onPath(3));
+    EXPECT_FALSE(dag.onPath(5));
+}
+
+TEST(PathDagTest, EmptyGraph) {
+    PathDag dag;
+    EXPECT_TRUE(dag.empty());
+    EXPECT_TRUE(dag.begin() == dag.end());
+
+    OptimalPaths<std::pair<int, int>> paths;
+    EXPECT_TRUE(paths.empty());
+    EXPECT_EQ(paths.size(), 0);
+    EXPECT_TRUE(paths.front().empty());
+    EXPECT_FALSE(paths.onPath(0, 0));
+}
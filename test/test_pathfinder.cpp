@@ -2,6 +2,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 using namespace cam::pathfinder;
 using namespace cam::math;
 
@@ -23,25 +25,36 @@ public:
         return PathFinder::computeHeuristic(pos, target);
     }
 
-    std::vector<std::vector<Type>>
+    Grid
     parse(const std::vector<std::string> &data) const override {
         return PathFinder::parse(data);
     }
 };
 
+// Every turn costs ten more than a straight move
+class TurnPenaltyPathFinder : public PathFinder {
+protected:
+    double
+    computeCost(const Node &current, const Vector2 &target) const override {
+        const auto dirs = getValidDirections();
+        const int  dir  = (int)(std::find(dirs.begin(), dirs.end(), target - current.pos) - dirs.begin());
+        return PathFinder::computeCost(current, target) + (current.parent >= 0 && dir != current.dir ? 10.0 : 0.0);
+    }
+};
+
 TEST(PathFinderTest, ParseMap) {
     MockPathFinder           pathFinder;
     std::vector<std::string> data = {"S.#", "...", "#.E"};
 
     auto table = pathFinder.parse(data);
 
-    ASSERT_EQ(table.size(), 3);
-    ASSERT_EQ(table[0].size(), 3);
+    ASSERT_EQ(table.getHeight(), 3);
+    ASSERT_EQ(table.getWidth(), 3);
 
-    EXPECT_EQ(table[0][0], START);
-    EXPECT_EQ(table[0][1], EMPTY);
-    EXPECT_EQ(table[0][2], BLOCK);
-    EXPECT_EQ(table[2][2], END);
+    EXPECT_EQ(table.at(0, 0), START);
+    EXPECT_EQ(table.at(1, 0), EMPTY);
+    EXPECT_EQ(table.at(2, 0), BLOCK);
+    EXPECT_EQ(table.at(2, 2), END);
 }
 
 TEST(PathFinderTest, SolveSimplePath) {
@@ -101,3 +114,264 @@ TEST(PathFinderTest, CanMove) {
     EXPECT_FALSE(pathFinder.canMove(Vector2(0, 0), Vector2(0, 2)));
     EXPECT_FALSE(pathFinder.canMove(Vector2(-1, -1), Vector2(-2, -2)));
 }
+
+TEST(PathFinderTest, AlternativesAreRebuiltPaths) {
+    MockPathFinder           pathFinder;
+    std::vector<std::string> data = {"S...", ".#..", "...E"};
+
+    pathFinder.set(data);
+    auto solution     = pathFinder.solve();
+    auto alternatives = pathFinder.alternatives();
+
+    ASSERT_FALSE(alternatives.empty());
+    EXPECT_EQ(solution, alternatives.front());
+    for(const auto &path : alternatives) {
+        ASSERT_EQ(path.size(), 6);
+        EXPECT_EQ(path.front(), Vector2(0, 0));
+        EXPECT_EQ(path.back(), Vector2(3, 2));
+        for(size_t idx = 1; idx < path.size(); idx++) {
+            EXPECT_EQ(path[idx - 1].distance(path[idx], MANHATTAN), 1.0);
+        }
+    }
+}
+
+TEST(PathFinderTest, IntegerCoreMatchesVirtualHooks) {
+    std::vector<std::string> data = {"S..#......", ".#.#.####.", ".#...#....", ".####.#.#.", "......#.#E"};
+
+    PathFinder     plain;
+    MockPathFinder hooked;
+    plain.set(data);
+    hooked.set(data);
+
+    auto plainSolution  = plain.solve();
+    auto hookedSolution = hooked.solve();
+
+    ASSERT_FALSE(plainSolution.empty());
+    EXPECT_EQ(plain.cost(), hooked.cost());
+    EXPECT_EQ(plainSolution.size(), hookedSolution.size());
+    EXPECT_EQ(plain.alternatives().size(), hooked.alternatives().size());
+}
+
+TEST(PathFinderTest, AlternativesOnOpenMap) {
+    PathFinder               pathFinder;
+    std::vector<std::string> data(40, std::string(40, '.'));
+    data[0][0]   = 'S';
+    data[39][39] = 'E';
+
+    pathFinder.set(data);
+    auto solution     = pathFinder.solve();
+    auto alternatives = pathFinder.alternatives();
+
+    // C(78, 39) paths, far more than could be listed one by one, saturate the counter
+    EXPECT_EQ(alternatives.size(), std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(alternatives.front(), solution);
+    EXPECT_TRUE(alternatives.onPath(20, 7));
+
+    size_t listed = 0;
+    for(auto it = alternatives.begin(); it != alternatives.end() && listed < 100; ++it, listed++) {
+        EXPECT_EQ(it->size(), 79);
+    }
+    EXPECT_EQ(listed, 100);
+
+    pathFinder.set({"S...", ".#..", "...E"});
+    pathFinder.solve();
+    EXPECT_EQ(pathFinder.alternatives().size(), 4);
+    EXPECT_FALSE(pathFinder.alternatives().onPath(1, 1));
+}
+
+TEST(PathFinderTest, MissingEndpoints) {
+    PathFinder pathFinder;
+
+    pathFinder.set({"S..", "...", "..."});
+    EXPECT_TRUE(pathFinder.solve().empty());
+    EXPECT_TRUE(pathFinder.alternatives().empty());
+
+    pathFinder.set({"S#.", "##.", "..E"});
+    EXPECT_TRUE(pathFinder.solve().empty());
+}
+
+TEST(PathFinderTest, JumpPointMatchesAStarCost) {
+    std::vector<std::string> data = {"S.........", "..####....", "..#..#.##.", "..#..#..#.", ".....#..#E"};
+
+    PathFinder astar;
+    PathFinder jump;
+    astar.set(data);
+    jump.set(data);
+    jump.setStrategy(Strategy::JUMP_POINT);
+
+    auto expected = astar.solve();
+    auto solution = jump.solve();
+
+    ASSERT_FALSE(solution.empty());
+    EXPECT_EQ(jump.cost(), astar.cost());
+    EXPECT_EQ(solution.size(), expected.size());
+    EXPECT_EQ(solution.front(), Vector2(0, 0));
+    EXPECT_EQ(solution.back(), Vector2(9, 4));
+    for(size_t idx = 1; idx < solution.size(); idx++) {
+        EXPECT_EQ(solution[idx - 1].distance(solution[idx], MANHATTAN), 1.0);
+    }
+
+    // Equivalent paths are searched once requested
+    EXPECT_EQ(jump.alternatives().size(), astar.alternatives().size());
+}
+
+TEST(PathFinderTest, JumpPointThroughVirtualHooks) {
+    MockPathFinder pathFinder;
+    pathFinder.set({"S#E", ".#.", "..."});
+    pathFinder.setStrategy(Strategy::JUMP_POINT);
+
+    auto solution = pathFinder.solve();
+
+    ASSERT_EQ(solution.size(), 7);
+    EXPECT_EQ(pathFinder.cost(), 6);
+    EXPECT_FALSE(pathFinder.alternatives().empty());
+
+    pathFinder.set({"S#E", "##.", "..."});
+    EXPECT_TRUE(pathFinder.solve().empty());
+}
+
+TEST(PathFinderTest, BidirectionalMatchesAStarCost) {
+    std::vector<std::string> data = {"S...#.....", ".##.#.###.", ".#..#...#.", ".#.####.#.", "........#E"};
+
+    PathFinder     astar;
+    PathFinder     bidirectional;
+    MockPathFinder hooked;
+    astar.set(data);
+    bidirectional.set(data);
+    hooked.set(data);
+    bidirectional.setStrategy(Strategy::BIDIRECTIONAL);
+    hooked.setStrategy(Strategy::BIDIRECTIONAL);
+
+    auto expected = astar.solve();
+    auto solution = bidirectional.solve();
+
+    ASSERT_FALSE(solution.empty());
+    EXPECT_EQ(bidirectional.cost(), astar.cost());
+    EXPECT_EQ(solution.size(), expected.size());
+    EXPECT_EQ(solution.front(), Vector2(0, 0));
+    EXPECT_EQ(solution.back(), Vector2(9, 4));
+    for(size_t idx = 1; idx < solution.size(); idx++) {
+        EXPECT_EQ(solution[idx - 1].distance(solution[idx], MANHATTAN), 1.0);
+    }
+    EXPECT_EQ(bidirectional.alternatives().size(), astar.alternatives().size());
+
+    EXPECT_EQ(hooked.solve().size(), expected.size());
+    EXPECT_EQ(hooked.cost(), astar.cost());
+}
+
+TEST(PathFinderTest, SolveBatch) {
+    std::vector<std::string> data = {"S...#.....", ".##.#.###.", ".#..#...#.", ".#.####.#.", "........#E"};
+    std::vector<Query>       queries = {
+        {{0, 0}, {9, 4}},
+        {{9, 4}, {0, 0}},
+        {{2, 2}, {2, 2}},
+        {{0, 0}, {4, 0}},     // blocked end
+        {{0, 0}, {10, 0}},    // outside the map
+        {{5, 0}, {9, 0}},
+    };
+
+    for(auto strategy : {Strategy::A_STAR, Strategy::JUMP_POINT, Strategy::BIDIRECTIONAL}) {
+        PathFinder     pathFinder;
+        MockPathFinder hooked;
+        pathFinder.set(data);
+        hooked.set(data);
+        pathFinder.setStrategy(strategy);
+        hooked.setStrategy(strategy);
+
+        pathFinder.solve();
+        double expected = pathFinder.cost();
+
+        std::vector<QueryResult> results;
+        pathFinder.solveBatch(queries, results);
+        ASSERT_EQ(results.size(), queries.size());
+
+        EXPECT_EQ(results[0].cost, expected);
+        EXPECT_EQ(results[0].path.size(), expected + 1);
+        EXPECT_EQ(results[0].path.front(), Vector2i(0, 0));
+        EXPECT_EQ(results[0].path.back(), Vector2i(9, 4));
+        EXPECT_EQ(results[1].cost, expected);
+        EXPECT_EQ(results[1].path.front(), Vector2i(9, 4));
+        EXPECT_EQ(results[2].cost, 0);
+        EXPECT_EQ(results[2].path.size(), 1);
+        EXPECT_TRUE(results[3].path.empty());
+        EXPECT_TRUE(results[4].path.empty());
+        EXPECT_EQ(results[5].cost, 4);
+
+        // Running again reuses the result storage
+        const auto *storage = results[0].path.data();
+        pathFinder.solveBatch(queries, results);
+        EXPECT_EQ(results[0].path.data(), storage);
+        EXPECT_EQ(results[0].cost, expected);
+
+        auto hookedResults = hooked.solveBatch(queries);
+        for(size_t idx = 0; idx < queries.size(); idx++) {
+            EXPECT_EQ(hookedResults[idx].cost, results[idx].cost);
+            EXPECT_EQ(hookedResults[idx].path.size(), results[idx].path.size());
+        }
+    }
+}
+
+TEST(PathFinderTest, WeightedTerrain) {
+    // Crossing the swamp is shorter but costs more than going around it
+    std::vector<std::string> data = {"S999E", ".999.", "....."};
+
+    for(auto strategy : {Strategy::A_STAR, Strategy::JUMP_POINT, Strategy::BIDIRECTIONAL}) {
+        PathFinder     pathFinder;
+        MockPathFinder hooked;
+        pathFinder.set(data);
+        hooked.set(data);
+        pathFinder.setStrategy(strategy);
+        hooked.setStrategy(strategy);
+
+        auto solution = pathFinder.solve();
+        ASSERT_EQ(solution.size(), 9);
+        EXPECT_EQ(solution[2], Vector2(0, 2));
+        EXPECT_EQ(pathFinder.cost(), 8);
+        EXPECT_EQ(pathFinder.alternatives().size(), 1);
+        EXPECT_EQ(hooked.solve().size(), 9);
+        EXPECT_EQ(hooked.cost(), 8);
+    }
+
+    MockPathFinder pathFinder;
+    auto           table = pathFinder.parse({"S3?E"});
+    EXPECT_EQ(table.weight(1, 0), 3);
+    EXPECT_EQ(table.at(1, 0), EMPTY);
+    EXPECT_EQ(table.at(2, 0), BLOCK);
+}
+
+TEST(PathFinderTest, WeightedAStarBound) {
+    std::vector<std::string> data = {"S.........", ".##.####..", ".#..#..#..", ".#.##.##..", "...#....#E"};
+
+    PathFinder astar;
+    PathFinder weighted;
+    astar.set(data);
+    weighted.set(data);
+    weighted.setStrategy(Strategy::WEIGHTED_A_STAR);
+    astar.solve();
+
+    for(double epsilon : {1.0, 1.5, 3.0}) {
+        weighted.setEpsilon(epsilon);
+        auto solution = weighted.solve();
+        ASSERT_FALSE(solution.empty());
+        EXPECT_EQ(solution.back(), Vector2(9, 4));
+        EXPECT_EQ(weighted.cost() + 1, solution.size());
+        EXPECT_LE(weighted.cost(), astar.cost() * epsilon);
+        EXPECT_GE(weighted.cost(), astar.cost());
+    }
+}
+
+TEST(PathFinderTest, DirectionDependentCosts) {
+    std::vector<std::string> data = {".....##E.", ".#.......", ".#.......", ".S..#...#", ".........", "........."};
+
+    // Reaching a cell cheaply with a turn ahead must not hide a costlier arrival that goes on straight
+    for(auto strategy : {Strategy::A_STAR, Strategy::BIDIRECTIONAL, Strategy::ANYTIME}) {
+        TurnPenaltyPathFinder pathFinder;
+        pathFinder.set(data);
+        pathFinder.setStrategy(strategy);
+        auto solution = pathFinder.solve();
+        ASSERT_FALSE(solution.empty());
+        EXPECT_EQ(solution.back(), Vector2(7, 0));
+        EXPECT_EQ(pathFinder.cost(), 31);
+        EXPECT_FALSE(pathFinder.alternatives().empty());
+    }
+}
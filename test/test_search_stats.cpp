@@ -0,0 +1,91 @@
+#include <pathfinder/BasicPathFinder.hpp>
+#include <pathfinder/PathFinder.hpp>
+#include <pathfinder/SearchStats.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace cam::pathfinder;
+using namespace cam::math;
+
+namespace {
+
+const std::vector<std::string> MAP = {
+    "S...#.....",
+    ".##.#.###.",
+    ".#..#...#.",
+    ".#.#.#.#..",
+    "........#E",
+};
+
+}    // namespace
+
+TEST(SearchStatsTest, DisabledByDefault) {
+    PathFinder finder;
+    finder.set(MAP);
+    EXPECT_FALSE(finder.solve().empty());
+    EXPECT_EQ(finder.stats().expanded, 0);
+    EXPECT_EQ(finder.stats().pushed, 0);
+    EXPECT_EQ(finder.stats().bytes, 0);
+}
+
+TEST(SearchStatsTest, CountsEveryStrategy) {
+    for(Strategy strategy : {Strategy::A_STAR, Strategy::JUMP_POINT, Strategy::BIDIRECTIONAL, Strategy::WEIGHTED_A_STAR,
+                             Strategy::ITERATIVE_DEEPENING, Strategy::MEMORY_BOUNDED, Strategy::ANYTIME}) {
+        PathFinder finder;
+        finder.set(MAP);
+        finder.setStrategy(strategy);
+        finder.setStatsEnabled(true);
+        EXPECT_FALSE(finder.solve().empty());
+
+        const SearchStats &stats = finder.stats();
+        EXPECT_GT(stats.expanded, 0);
+        EXPECT_GE(stats.popped, stats.expanded);
+        EXPECT_GE(stats.pushed, stats.popped);
+        EXPECT_GT(stats.peakOpen, 0);
+        EXPECT_LE(stats.peakOpen, stats.pushed);
+        EXPECT_GT(stats.bytes, 0);
+        EXPECT_GT(stats.searchTime.count(), 0);
+    }
+}
+
+TEST(SearchStatsTest, ResetBySolve) {
+    BasicPathFinder<> finder;
+    Grid              grid(16, 16);
+    grid.set(0, 0, START);
+    grid.set(15, 15, END);
+    finder.set(grid);
+    finder.setStatsEnabled(true);
+
+    finder.solve();
+    const SearchStats first = finder.stats();
+    finder.solve();
+    EXPECT_EQ(finder.stats().expanded, first.expanded);
+    EXPECT_EQ(finder.stats().pushed, first.pushed);
+    EXPECT_GT(first.skipped, 0);
+    EXPECT_GT(first.graphTime.count(), 0);
+
+    finder.setStatsEnabled(false);
+    finder.solve();
+    EXPECT_EQ(finder.stats().expanded, 0);
+}
+
+TEST(SearchStatsTest, TraceHeatmap) {
+    PathFinder finder;
+    finder.set(MAP);
+
+    ExpansionHeatmap heatmap;
+    uint64_t         traced = 0;
+    finder.setTrace(heatmap.callback());
+    finder.solve();
+    EXPECT_EQ(heatmap.expansions(), finder.stats().expanded);
+    EXPECT_TRUE(heatmap.expanded(finder.getMap().find(START)));
+
+    finder.setTrace([&traced](uint32_t, uint64_t order) { traced = order + 1; });
+    finder.solve();
+    EXPECT_EQ(traced, finder.stats().expanded);
+
+    const std::string printed = heatmap.render(finder.getMap());
+    EXPECT_EQ(printed.size(), 1 + MAP.size() * (MAP[0].size() + 1));
+    EXPECT_EQ(printed[1], '0');
+    EXPECT_EQ(printed[1 + 4], '#');
+}